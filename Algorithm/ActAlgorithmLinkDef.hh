@@ -23,6 +23,8 @@
 #pragma link C++ class ActAlgorithm::Interval < float> + ;
 #pragma link C++ class ActAlgorithm::IntervalMap < int> + ;
 #pragma link C++ class ActAlgorithm::IntervalMap < float> + ;
+#pragma link C++ class ActAlgorithm::ClusterMerger;
+#pragma link C++ class ActAlgorithm::ActionProfiler;
 
 // Filter algorithms
 #pragma link C++ class ActAlgorithm::VFilter;
@@ -14,6 +14,7 @@ private:
     double fDistThresh {};        //!< Min distance of cluster line to others cluster line gravity point
     double fMinParallelFactor {}; //!< Min parallelity between 2 clusters to consider merging
     double fChi2Factor {};
+    double fMaxGap {-1}; //!< Max separation of bounding boxes to consider merging. Negative to disable
 
 public:
     Merge() : VAction("Merge") {};
@@ -87,6 +87,8 @@ ActAlgorithm::Actions::Split::PairsVector ActAlgorithm::Actions::Split::GetInlie
     PairsVector inliersAndOutliersVector {};
 
     const auto& voxels = cluster->GetVoxels();
+    // Event-keyed stream of the cluster algorithm if available
+    TRandom* rand {fAlgo ? fAlgo->GetRandom() : gRandom};
     for(int i = 0; i < fNiterRANSAC; i++)
     {
         ActRoot::Cluster inliers {};
@@ -94,8 +96,8 @@ ActAlgorithm::Actions::Split::PairsVector ActAlgorithm::Actions::Split::GetInlie
 
         // 1. Select a random subset of points to be the model
         double sizeCluster = voxels.size();
-        auto voxel1 = voxels[gRandom->Integer(sizeCluster)];
-        auto voxel2 = voxels[gRandom->Integer(sizeCluster)];
+        auto voxel1 = voxels[rand->Integer(sizeCluster)];
+        auto voxel2 = voxels[rand->Integer(sizeCluster)];
         // 2. Solve for the model
         ActRoot::Line line(voxel1.GetPosition(), voxel2.GetPosition());
         // 3. Find the inliers to the model
@@ -0,0 +1,85 @@
+#ifndef ActActionProfiler_h
+#define ActActionProfiler_h
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace ActAlgorithm
+{
+//! Latency statistics of the actions of MultiAction
+/*!
+  For each action, wall time of each call is stored in a histogram of logarithmic bins
+  (fBinsPerDecade from 1 us to 100 s), from which p50 and p99 are estimated, together with
+  the number of calls, total and maximum time and the voxels in clusters before and after it.
+  The slowest events are kept with their (run, entry) so they can be replayed.
+  Profilers of different threads are combined with Merge
+*/
+class ActionProfiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    //! Statistics of a single action
+    class Stats
+    {
+    public:
+        std::string fName {};
+        unsigned long fNCalls {};
+        double fTotal {}; //!< Seconds
+        double fMax {};   //!< Seconds
+        unsigned long long fVoxelsIn {};
+        unsigned long long fVoxelsOut {};
+        std::vector<unsigned long> fHist {};
+
+        void Add(double time, int voxelsIn, int voxelsOut);
+        void Merge(const Stats& other);
+        double GetQuantile(double q) const;
+    };
+    //! Total time of an event
+    class Event
+    {
+    public:
+        double fTime {};
+        int fRun {-1};
+        int fEntry {-1};
+    };
+
+    inline static const int fBinsPerDecade {20};
+    inline static const double fMinTime {1e-6}; //!< Lower edge of histograms
+    inline static const int fNBins {8 * fBinsPerDecade};
+
+private:
+    std::vector<Stats> fActions {};
+    Stats fTotal {};                //!< Whole event
+    std::vector<Event> fSlowest {}; //!< Heap with the fastest of the slowest events on top
+    int fNSlowest {10};
+    // Current event
+    Event fCurrent {};
+    int fCurrentIn {};
+    Clock::time_point fStart {};
+
+public:
+    ActionProfiler() = default;
+
+    void Init(const std::vector<std::string>& names);
+    void SetNSlowest(int n) { fNSlowest = n; }
+
+    // Filling
+    void StartEvent(int run, int entry, int voxelsIn);
+    void AddAction(int idx, Clock::time_point start, int voxelsIn, int voxelsOut);
+    void EndEvent(int voxelsOut);
+
+    // Combine with profiler of another thread
+    void Merge(const ActionProfiler& other);
+
+    void Print() const;
+    void Write(const std::string& file) const;
+
+private:
+    std::vector<Event> GetSlowest() const;
+    void PushSlowest(const Event& event);
+};
+} // namespace ActAlgorithm
+
+#endif // !ActActionProfiler_h
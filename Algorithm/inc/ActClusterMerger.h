@@ -0,0 +1,67 @@
+#ifndef ActClusterMerger_h
+#define ActClusterMerger_h
+
+#include "ActCluster.h"
+#include "ActLine.h"
+
+#include "Math/Vector3D.h"
+
+#include <array>
+#include <vector>
+
+namespace ActAlgorithm
+{
+//! Merges clusters that are close, parallel and whose joint fit improves
+/*!
+  Pairs are merged when the distance from each gravity point to the other line is below DistThresh,
+  |u_i . u_j| is above MinParallelFactor and the chi2 of the joint fit is below Chi2Factor times the
+  quadratic sum of both. Joint fits are computed from the moments of the clusters, so no voxels are
+  copied. Moments, directions and bounding boxes are cached per cluster and updated on each merge.
+  Optionally (MaxGap >= 0), pairs whose bounding boxes are farther apart than MaxGap along any axis
+  are rejected before any other check. It is disabled by default because distances are computed to
+  infinite lines, so collinear clusters far apart can be merged
+*/
+class ClusterMerger
+{
+public:
+    using XYZVectorF = ROOT::Math::XYZVectorF;
+    using Box = std::array<ActRoot::Cluster::RangeType, 3>;
+
+private:
+    double fDistThresh {};
+    double fMinParallelFactor {};
+    double fChi2Factor {};
+    double fMaxGap {-1}; //!< Negative to disable bounding box rejection
+    bool fIsVerbose {};
+    // Per cluster caches
+    std::vector<ActRoot::LineMoments> fMoments {};
+    std::vector<XYZVectorF> fDirs {}; //!< Unit directions of lines
+    std::vector<Box> fBoxes {};
+    std::vector<char> fDeleted {};
+
+public:
+    ClusterMerger() = default;
+    ClusterMerger(double distThresh, double minParallelFactor, double chi2Factor, bool isVerbose = false)
+        : fDistThresh(distThresh),
+          fMinParallelFactor(minParallelFactor),
+          fChi2Factor(chi2Factor),
+          fIsVerbose(isVerbose)
+    {
+    }
+
+    // Setters
+    void SetMaxGap(double gap) { fMaxGap = gap; }
+    void SetIsVerbose(bool verbose) { fIsVerbose = verbose; }
+
+    void Run(std::vector<ActRoot::Cluster>& clusters);
+
+private:
+    void Init(const std::vector<ActRoot::Cluster>& clusters);
+    float GetGap(int i, int j) const;
+    bool IsCandidate(const std::vector<ActRoot::Cluster>& clusters, int i, int j) const;
+    bool ImprovesFit(const std::vector<ActRoot::Cluster>& clusters, int i, int j) const;
+    void Merge(std::vector<ActRoot::Cluster>& clusters, int i, int j);
+};
+} // namespace ActAlgorithm
+
+#endif // !ActClusterMerger_h
@@ -3,10 +3,13 @@
 
 #include "ActVCluster.h"
 #include "ActVoxel.h"
+#include "ActVoxelCloud.h"
 
 #include "TStopwatch.h"
 
+#include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 // forward declaration to avoid circular dependencies
@@ -18,15 +21,37 @@ class TPCParameters;
 namespace ActAlgorithm
 {
 //! Implementation of a continuity-based cluster algorithm by J. Lois-Fuentes
+/*!
+  Clusters are grown by BFS over the 26-neighbourhood. Alternatively (Method UnionFind in
+  continuity.conf), connected components are labelled with a union-find run in parallel over
+  z slabs of the pad grid and merged at slab boundaries. Both methods yield the same clusters,
+  in the same order, but voxels are sorted by input index instead of BFS generation
+*/
 class Continuity : public VCluster
 {
 private:
     // Timer
     TStopwatch fClock {};
-    std::vector<std::vector<std::vector<int>>> fMatrix; //!< 3D matrix to locate clusters in space
-    std::vector<ActRoot::Voxel> fVoxels;                //!< Local copy of vector to be treated
+    std::vector<unsigned long long> fOccupied; //!< Bit per cell [x][y][z] of the pad matrix, set if it holds a voxel
+    std::vector<int> fCellKeys;                //!< Hash table from occupied cell (-1 = empty slot)...
+    std::vector<int> fCellVoxels;              //!< ...to index of the voxel in it
+    int fHashBits {};                          //!< Size of hash table is 2^fHashBits
+    bool fHasDuplicates {};                    //!< Some voxels of the event share a cell
+    int fNX {};
+    int fNY {};
+    int fNZ {};
+    const std::vector<ActRoot::Voxel>* fVoxels {}; //!< Voxels being treated, only read
+    ActRoot::VoxelCloud fCloud;                     //!< Coordinates of fVoxels in contiguous arrays
     std::vector<int> fIndexes;
+    int fCursor {};                  //!< Seeds before it are already masked in fIndexes
     ActRoot::TPCParameters* fTPC {}; //!< Pointer to TPC parameters needed to define algorithm parameters
+    // Union-find labelling
+    bool fUseUnionFind {};                                     //!< Use union-find instead of BFS
+    int fNThreads {};                                          //!< Size of shared pool, fixed on first use. 0 = all
+    int fMinParallelVoxels {5000};                             //!< Smaller events are labelled in a single slab
+    std::vector<int> fParents;                                 //!< Union-find forest over voxel indexes
+    std::vector<std::vector<int>> fSlabs;                      //!< Voxels in the matrix of each z slab
+    std::vector<std::vector<std::pair<int, int>>> fBoundaries; //!< Edges from each slab to the next one
 public:
     Continuity() = default;
     Continuity(ActRoot::TPCParameters* tpc, int minPoints);
@@ -41,6 +66,9 @@ public:
         fTPC = tpc;
         InitMatrix();
     }
+    void SetUseUnionFind(bool use) { fUseUnionFind = use; }
+    void SetNThreads(int n) { fNThreads = n; }
+    void SetMinParallelVoxels(int min) { fMinParallelVoxels = min; }
 
     // Main method
     ClusterRet Run(const std::vector<ActRoot::Voxel>& voxels, bool addNoise = false) override;
@@ -55,10 +83,23 @@ private:
     void FillMatrix();
     std::vector<int> ScanNeighborhood(const std::vector<int>& gen0);
     std::tuple<int, int, int> GetCoordinates(int index);
+    int GetCell(int x, int y, int z) const { return (x * fNY + y) * fNZ + z; }
+    int GetSlot(int cell) const;
+    int FindVoxel(int cell) const;
+    void SetVoxel(int cell, int index);
+    int NextSeed();
     void MaskVoxelsInMatrix(int index);
     void MaskVoxelsInIndex(int index);
     template <typename T>
     bool IsInCage(T x, T y, T z);
+    // Union-find
+    bool IsOccupant(int index);
+    int FindRoot(int index);
+    void Unite(int a, int b);
+    void LabelSlab(int slab, int zmax);
+    void LabelComponents();
+    ClusterRet RunUnionFind(bool addNoise);
+    void AddCluster(ActRoot::Cluster& cluster, ClusterRet& ret, bool addNoise);
 };
 } // namespace ActAlgorithm
 
@@ -1,13 +1,12 @@
 #ifndef ActMultiAction_h
 #define ActMultiAction_h
 
+#include "ActActionProfiler.h"
 #include "ActInputParser.h"
 #include "ActVAction.h"
 #include "ActVCluster.h"
 #include "ActVFilter.h"
 
-#include "TStopwatch.h"
-
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -32,7 +31,9 @@ private:
     MapActions fMap {};           //!< Known actions to instantiate
     std::vector<Ptr> fActions {}; //!< Actions by order in file
 
-    TStopwatch fTimer {}; //!< To control time spent in executing the actions
+    ActionProfiler fProfiler {}; //!< Latency of each action
+    bool fProfile {true};
+    std::string fProfileFile {}; //!< If not empty, profile is written here in PrintReports
 
 public:
     MultiAction();
@@ -45,6 +46,7 @@ public:
     void Run() override;
     void Print() const override;
     void PrintReports() const override;
+    bool MergeReports(const VFilter& other) override;
 
     MapActions& GetActionsMap() { return fMap; }
     Ptr ConstructAction(const std::string& actionID);
@@ -55,6 +57,7 @@ public:
 private:
     void LoadUserAction(std::shared_ptr<ActRoot::InputBlock> block);
     void ResetClusterID();
+    int GetNClusteredVoxels() const;
 };
 
 template <typename T>
@@ -4,6 +4,7 @@
 #include "ActLine.h"
 #include "ActVCluster.h"
 #include "ActVoxel.h"
+#include "ActVoxelCloud.h"
 
 #include "TStopwatch.h"
 
@@ -15,6 +16,14 @@
 //! A namespace with all clustering utilities
 namespace ActAlgorithm
 {
+//! RANSAC search of lines
+/*!
+  Optionally (Adaptive in ransac.conf), iterations stop once the smallest accepted line, with
+  inlier ratio w = MinPoints / size, has been sampled with the requested Confidence, that is after
+  log(1 - Confidence) / log(1 - w^2) samples, with Iterations as maximum. Samples are then first
+  scored on a random subset of PreemptiveSize voxels, and rejected without a full scan if they
+  cannot reach MinPoints
+*/
 class RANSAC : public VCluster
 {
 private:
@@ -23,6 +32,16 @@ private:
     int fIterations {150};
     int fNPointsToSample {2}; // 2 always for a line
     bool fUseLmeds {false};
+    // Adaptive termination
+    bool fAdaptive {false};
+    double fConfidence {0.99};
+    int fPreemptiveSize {100}; //!< 0 disables preemptive scoring
+    ActRoot::VoxelCloud fCloud {};  //!< Voxels in contiguous arrays for the distance kernel
+    std::vector<int> fOrder {};     //!< Order of voxels in fCloud
+    std::vector<double> fErrors {}; //!< Buffer of LMedS errors
+    // Report
+    unsigned long fNRuns {};
+    unsigned long fNIters {};
 
 public:
     RANSAC() = default;
@@ -35,6 +54,11 @@ public:
 
     void SetDistThreshold(double thresh) { fDistThreshold = thresh; }
     void SetIterations(int iter) { fIterations = iter; }
+    void SetAdaptive(bool adaptive, double confidence = 0.99)
+    {
+        fAdaptive = adaptive;
+        fConfidence = confidence;
+    }
 
     // Main method
     VCluster::ClusterRet Run(const std::vector<ActRoot::Voxel>& voxels, bool addNoise = false) override;
@@ -46,7 +70,9 @@ public:
     void PrintReports() const override;
 
 private:
-    int GetNInliers(const std::vector<ActRoot::Voxel>& voxels, ActRoot::Line& line);
+    void FillCoordinates(const std::vector<ActRoot::Voxel>& voxels);
+    int CountInliers(const ActRoot::Line& line, int begin, int end) const;
+    int GetNInliers(ActRoot::Line& line);
     std::vector<ActRoot::Voxel> ProcessCloud(std::vector<ActRoot::Voxel>& remain, const ActRoot::Line& line);
     ActRoot::Line SampleLine(const std::vector<ActRoot::Voxel>& voxels);
     template <typename T>
@@ -4,6 +4,8 @@
 #include "ActCluster.h"
 #include "ActVoxel.h"
 
+#include "TRandom.h"
+
 #include <utility>
 #include <vector>
 
@@ -16,6 +18,7 @@ public:
 
 protected:
     int fMinPoints {};
+    TRandom* fRand {}; //!< Generator for sampling. gRandom if not set
 
 public:
     VCluster() = default;
@@ -25,6 +28,9 @@ public:
     void SetMinPoint(int npoints) { fMinPoints = npoints; }
     int GetMinPoints() const { return fMinPoints; }
 
+    void SetRandom(TRandom* rand) { fRand = rand; }
+    TRandom* GetRandom() const { return fRand ? fRand : gRandom; }
+
     virtual void ReadConfiguration() = 0;
     virtual ClusterRet Run(const std::vector<ActRoot::Voxel>& voxels, bool addNoise = false) = 0;
     virtual void Print() const = 0;
@@ -18,6 +18,8 @@ protected:
     ActRoot::MergerData* fMergerData {};
     std::shared_ptr<ActAlgorithm::VCluster> fAlgo {};
     bool fIsVerbose {};
+    int fRun {-1};   //!< Current event, for reports
+    int fEntry {-1}; //!< Current event, for reports
 
 public:
     VFilter() = default;
@@ -37,10 +39,18 @@ public:
     void SetIsVerbose(bool verb = true) { fIsVerbose = verb; }
     bool GetIsVerbose() const { return fIsVerbose; }
 
+    void SetEvent(int run, int entry)
+    {
+        fRun = run;
+        fEntry = entry;
+    }
+
     virtual void ReadConfiguration() = 0;
     virtual void Run() = 0;
     virtual void Print() const = 0;
     virtual void PrintReports() const = 0;
+    //! Accumulate reports of the same filter in another thread. Returns false if not supported
+    virtual bool MergeReports(const VFilter& other) { return false; }
 };
 } // namespace ActAlgorithm
 
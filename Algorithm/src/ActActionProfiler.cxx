@@ -0,0 +1,185 @@
+#include "ActActionProfiler.h"
+
+#include "ActColors.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Heap with the fastest event on top
+bool IsSlower(const ActAlgorithm::ActionProfiler::Event& a, const ActAlgorithm::ActionProfiler::Event& b)
+{
+    return a.fTime > b.fTime;
+}
+} // namespace
+
+void ActAlgorithm::ActionProfiler::Stats::Add(double time, int voxelsIn, int voxelsOut)
+{
+    if(fHist.empty())
+        fHist.assign(fNBins, 0);
+    int bin {};
+    if(time > fMinTime)
+        bin = std::min(static_cast<int>(std::log10(time / fMinTime) * fBinsPerDecade), fNBins - 1);
+    fHist[bin]++;
+    fNCalls++;
+    fTotal += time;
+    fMax = std::max(fMax, time);
+    fVoxelsIn += voxelsIn;
+    fVoxelsOut += voxelsOut;
+}
+
+void ActAlgorithm::ActionProfiler::Stats::Merge(const Stats& other)
+{
+    if(other.fNCalls == 0)
+        return;
+    if(fHist.empty())
+        fHist.assign(fNBins, 0);
+    for(int b = 0; b < fNBins; b++)
+        fHist[b] += other.fHist[b];
+    fNCalls += other.fNCalls;
+    fTotal += other.fTotal;
+    fMax = std::max(fMax, other.fMax);
+    fVoxelsIn += other.fVoxelsIn;
+    fVoxelsOut += other.fVoxelsOut;
+}
+
+double ActAlgorithm::ActionProfiler::Stats::GetQuantile(double q) const
+{
+    if(fNCalls == 0)
+        return 0;
+    // Upper edge of the bin containing the quantile, but never above the maximum
+    auto target {q * fNCalls};
+    unsigned long cumulative {};
+    for(int b = 0; b < fNBins; b++)
+    {
+        cumulative += fHist[b];
+        if(cumulative >= target)
+            return std::min(fMinTime * std::pow(10., static_cast<double>(b + 1) / fBinsPerDecade), fMax);
+    }
+    return fMax;
+}
+
+void ActAlgorithm::ActionProfiler::Init(const std::vector<std::string>& names)
+{
+    fActions.clear();
+    for(const auto& name : names)
+        fActions.push_back({name});
+    fTotal = {"Total"};
+    fSlowest.clear();
+}
+
+void ActAlgorithm::ActionProfiler::StartEvent(int run, int entry, int voxelsIn)
+{
+    fCurrent = {0, run, entry};
+    fCurrentIn = voxelsIn;
+    fStart = Clock::now();
+}
+
+void ActAlgorithm::ActionProfiler::AddAction(int idx, Clock::time_point start, int voxelsIn, int voxelsOut)
+{
+    std::chrono::duration<double> time {Clock::now() - start};
+    fActions[idx].Add(time.count(), voxelsIn, voxelsOut);
+}
+
+void ActAlgorithm::ActionProfiler::EndEvent(int voxelsOut)
+{
+    std::chrono::duration<double> time {Clock::now() - fStart};
+    fCurrent.fTime = time.count();
+    fTotal.Add(fCurrent.fTime, fCurrentIn, voxelsOut);
+    PushSlowest(fCurrent);
+}
+
+void ActAlgorithm::ActionProfiler::PushSlowest(const Event& event)
+{
+    if(fNSlowest <= 0)
+        return;
+    if(static_cast<int>(fSlowest.size()) < fNSlowest)
+    {
+        fSlowest.push_back(event);
+        std::push_heap(fSlowest.begin(), fSlowest.end(), IsSlower);
+    }
+    else if(event.fTime > fSlowest.front().fTime)
+    {
+        std::pop_heap(fSlowest.begin(), fSlowest.end(), IsSlower);
+        fSlowest.back() = event;
+        std::push_heap(fSlowest.begin(), fSlowest.end(), IsSlower);
+    }
+}
+
+void ActAlgorithm::ActionProfiler::Merge(const ActionProfiler& other)
+{
+    if(other.fActions.size() != fActions.size())
+        throw std::runtime_error("ActionProfiler::Merge(): profilers have different number of actions");
+    for(int i = 0, size = fActions.size(); i < size; i++)
+        fActions[i].Merge(other.fActions[i]);
+    fTotal.Merge(other.fTotal);
+    for(const auto& event : other.fSlowest)
+        PushSlowest(event);
+}
+
+std::vector<ActAlgorithm::ActionProfiler::Event> ActAlgorithm::ActionProfiler::GetSlowest() const
+{
+    auto ret {fSlowest};
+    std::sort(ret.begin(), ret.end(), IsSlower);
+    return ret;
+}
+
+void ActAlgorithm::ActionProfiler::Print() const
+{
+    auto precision {std::cout.precision()};
+    std::cout << BOLDYELLOW << "···· MultiAction time report ····" << '\n';
+    std::cout << std::left << std::setw(16) << "Action" << std::right << std::setw(10) << "Calls" << std::setw(11)
+              << "Total [s]" << std::setw(12) << "Mean [us]" << std::setw(12) << "p50 [us]" << std::setw(12)
+              << "p99 [us]" << std::setw(12) << "Max [us]" << std::setw(13) << "Voxels in" << std::setw(13)
+              << "Voxels out" << '\n';
+    auto print = [](const Stats& stats)
+    {
+        double mean {stats.fNCalls ? stats.fTotal / stats.fNCalls : 0};
+        std::cout << std::left << std::setw(16) << stats.fName << std::right << std::setw(10) << stats.fNCalls
+                  << std::setw(11) << std::setprecision(4) << stats.fTotal << std::setw(12) << std::setprecision(4)
+                  << mean * 1e6 << std::setw(12) << stats.GetQuantile(0.5) * 1e6 << std::setw(12)
+                  << stats.GetQuantile(0.99) * 1e6 << std::setw(12) << stats.fMax * 1e6 << std::setw(13)
+                  << stats.fVoxelsIn << std::setw(13) << stats.fVoxelsOut << '\n';
+    };
+    for(const auto& stats : fActions)
+        print(stats);
+    print(fTotal);
+    if(!fSlowest.empty())
+    {
+        std::cout << "-> Slowest events (run, entry) : time [us]" << '\n';
+        for(const auto& event : GetSlowest())
+            std::cout << "   (" << event.fRun << ", " << event.fEntry << ") : " << event.fTime * 1e6 << '\n';
+    }
+    std::cout << "······························" << RESET << '\n';
+    std::cout.precision(precision);
+}
+
+void ActAlgorithm::ActionProfiler::Write(const std::string& file) const
+{
+    std::ofstream streamer {file};
+    if(!streamer)
+        throw std::runtime_error("ActionProfiler::Write(): could not open file " + file);
+    // Plain table: one row per action, then slowest events
+    streamer << "# Action Calls Total[s] Mean[us] p50[us] p99[us] Max[us] VoxelsIn VoxelsOut" << '\n';
+    auto write = [&](const Stats& stats)
+    {
+        double mean {stats.fNCalls ? stats.fTotal / stats.fNCalls : 0};
+        streamer << stats.fName << " " << stats.fNCalls << " " << stats.fTotal << " " << mean * 1e6 << " "
+                 << stats.GetQuantile(0.5) * 1e6 << " " << stats.GetQuantile(0.99) * 1e6 << " " << stats.fMax * 1e6
+                 << " " << stats.fVoxelsIn << " " << stats.fVoxelsOut << '\n';
+    };
+    for(const auto& stats : fActions)
+        write(stats);
+    write(fTotal);
+    streamer << "# Run Entry Time[us]" << '\n';
+    for(const auto& event : GetSlowest())
+        streamer << event.fRun << " " << event.fEntry << " " << event.fTime * 1e6 << '\n';
+}
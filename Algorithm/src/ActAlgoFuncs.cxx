@@ -1,6 +1,7 @@
 #include "ActAlgoFuncs.h"
 
 #include "ActCluster.h"
+#include "ActClusterMerger.h"
 #include "ActColors.h"
 #include "ActRegion.h"
 #include "ActTPCParameters.h"
@@ -136,133 +137,8 @@ bool ActAlgorithm::IsRPValid(const XYZPoint& rp, ActRoot::TPCParameters* tpc)
 void ActAlgorithm::MergeSimilarClusters(std::vector<ActRoot::Cluster>* clusters, double distThresh,
                                         double minParallelFactor, double chi2Factor, bool isVerbose)
 {
-    // Sort clusters by increasing voxel size
-    std::sort(clusters->begin(), clusters->end(), [](const ActRoot::Cluster& l, const ActRoot::Cluster& r)
-              { return l.GetSizeOfVoxels() < r.GetSizeOfVoxels(); });
-    // Verbose
-    if(isVerbose)
-        std::cout << BOLDYELLOW << "---- MergeSimilarClusters ----" << '\n';
-
-    // Set of indexes to delete
-    std::set<int, std::greater<int>> toDelete {};
-    // Run!
-    for(size_t i = 0, isize = clusters->size(); i < isize; i++)
-    {
-        // Get clusters as iterators
-        auto iit {clusters->begin() + i};
-        for(size_t j = 0, jsize = clusters->size(); j < jsize; j++)
-        {
-            if(isVerbose)
-                std::cout << "<i, j> : <" << i << ", " << j << ">" << '\n';
-
-            bool isIinSet {toDelete.find(i) != toDelete.end()};
-            bool isJinSet {toDelete.find(j) != toDelete.end()};
-            if(i == j || isIinSet || isJinSet) // exclude comparison of same cluster and other already to be deleted
-            {
-                if(isVerbose)
-                    std::cout << "   skipping j" << '\n';
-                continue;
-            }
-
-            // Get inner iterator
-            auto jit {clusters->begin() + j};
-
-            // If any of them is set not to merge, do not do that :)
-            if(!iit->GetToMerge() || !jit->GetToMerge())
-            {
-                if(isVerbose)
-                    std::cout << "   i or j are set not to merge" << '\n';
-                continue;
-            }
-
-            // 1-> Compare by distance from gravity point to line!
-            auto gravIn {jit->GetLine().GetPoint()};
-            auto distIn {iit->GetLine().DistanceLineToPoint(gravIn)};
-            auto gravOut {iit->GetLine().GetPoint()};
-            auto distOut {jit->GetLine().DistanceLineToPoint(gravOut)};
-            auto dist {std::max(distIn, distOut)};
-            // Get threshold distance to merge
-            bool isBelowThresh {dist <= distThresh};
-
-            // 2-> Compare by paralelity
-            auto outDir {iit->GetLine().GetDirection().Unit()};
-            auto inDir {jit->GetLine().GetDirection().Unit()};
-            bool areParallel {std::abs(outDir.Dot(inDir)) > minParallelFactor};
-
-            if(isVerbose)
-            {
-                std::cout << "   dist < distThres ? " << dist << " < " << distThresh << '\n';
-                std::cout << "   are parellel ? " << std::boolalpha << areParallel << '\n';
-            }
-
-            // 3-> Check if fit improves
-            if(isBelowThresh && areParallel)
-            {
-                // Sum voxels from both cluster
-                std::vector<ActRoot::Voxel> sumVoxels;
-                sumVoxels.reserve(iit->GetPtrToVoxels()->size() + jit->GetPtrToVoxels()->size());
-                // Add i
-                sumVoxels.insert(sumVoxels.end(), iit->GetPtrToVoxels()->begin(), iit->GetPtrToVoxels()->end());
-                // Add j
-                sumVoxels.insert(sumVoxels.end(), jit->GetPtrToVoxels()->begin(), jit->GetPtrToVoxels()->end());
-                // And get fit of summed voxels
-                ActRoot::Line sumLine {};
-                sumLine.FitVoxels(sumVoxels);
-                // Compare Chi2
-                auto newChi2 {sumLine.GetChi2()};
-                // oldChi2 is obtained by quadratic sum of chi2s
-                auto oldChi2 {std::sqrt(std::pow(iit->GetLine().GetChi2(), 2) + std::pow(jit->GetLine().GetChi2(), 2))};
-                // auto oldChi2 {std::max(out->GetLine().GetChi2(), in->GetLine().GetChi2())};
-                bool improvesFit {newChi2 < chi2Factor * oldChi2};
-
-                if(isVerbose)
-                    std::cout << "   newChi2 < f * oldChi2 ? : " << newChi2 << " < " << chi2Factor * oldChi2 << '\n';
-
-                // Check whether fit is improved: reduces chi2
-                if(improvesFit)
-                {
-                    // Save in bigger cluster
-                    // and delete smaller one
-                    std::vector<ActRoot::Cluster>::iterator itSave, itDel;
-                    int idxDel;
-                    if(iit->GetSizeOfVoxels() > jit->GetSizeOfVoxels())
-                    {
-                        itSave = iit;
-                        itDel = jit;
-                        idxDel = j;
-                    }
-                    else
-                    {
-                        itSave = jit;
-                        itDel = iit;
-                        idxDel = i;
-                    }
-                    auto& saveVoxels {itSave->GetRefToVoxels()};
-                    auto& delVoxels {itDel->GetRefToVoxels()};
-                    saveVoxels.insert(saveVoxels.end(), std::make_move_iterator(delVoxels.begin()),
-                                      std::make_move_iterator(delVoxels.end()));
-                    // Refit and recompute ranges
-                    itSave->ReFit();
-                    itSave->ReFillSets();
-                    // Mark to delete afterwards!
-                    toDelete.insert(idxDel);
-                    // Verbose info
-                    if(isVerbose)
-                    {
-                        std::cout << "   => merge cluster #" << itDel->GetClusterID()
-                                  << " and size : " << itDel->GetSizeOfVoxels() << '\n';
-                        std::cout << "      with cluster #" << itSave->GetClusterID()
-                                  << " and size : " << itSave->GetSizeOfVoxels() << '\n';
-                    }
-                }
-            }
-        }
-    }
-    // Delete clusters
-    for(const auto& idx : toDelete) // toDelete is sorted in greater order
-        clusters->erase(clusters->begin() + idx);
-    if(isVerbose)
-        std::cout << RESET << '\n';
+    ClusterMerger merger {distThresh, minParallelFactor, chi2Factor, isVerbose};
+    merger.Run(*clusters);
 }
 
 void ActAlgorithm::CylinderCleaning(std::vector<ActRoot::Cluster>* cluster, double cylinderR, int minVoxels,
@@ -0,0 +1,179 @@
+#include "ActClusterMerger.h"
+
+#include "ActCluster.h"
+#include "ActColors.h"
+#include "ActLine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ios>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+void ActAlgorithm::ClusterMerger::Init(const std::vector<ActRoot::Cluster>& clusters)
+{
+    auto size {clusters.size()};
+    fMoments.assign(size, ActRoot::LineMoments {});
+    fDirs.resize(size);
+    fBoxes.resize(size);
+    fDeleted.assign(size, false);
+    for(size_t i = 0; i < size; i++)
+    {
+        const auto& cluster {clusters[i]};
+        // Same weights as in the default Line::FitVoxels
+        fMoments[i].Add(cluster.GetVoxels());
+        fDirs[i] = cluster.GetLine().GetDirection().Unit();
+        // Bounding box of voxels, not taken from the cluster ranges in case they are not filled
+        auto& box {fBoxes[i]};
+        box.fill({1111, -1});
+        for(const auto& voxel : cluster.GetVoxels())
+        {
+            const auto& pos {voxel.GetPosition()};
+            float coords[3] {pos.X(), pos.Y(), pos.Z()};
+            for(int k = 0; k < 3; k++)
+            {
+                box[k].first = std::min(box[k].first, coords[k]);
+                box[k].second = std::max(box[k].second, coords[k]);
+            }
+        }
+    }
+}
+
+float ActAlgorithm::ClusterMerger::GetGap(int i, int j) const
+{
+    // Largest separation along any axis: <= 0 if boxes overlap
+    float gap {};
+    for(int k = 0; k < 3; k++)
+    {
+        const auto& [imin, imax] {fBoxes[i][k]};
+        const auto& [jmin, jmax] {fBoxes[j][k]};
+        gap = std::max({gap, jmin - imax, imin - jmax});
+    }
+    return gap;
+}
+
+bool ActAlgorithm::ClusterMerger::IsCandidate(const std::vector<ActRoot::Cluster>& clusters, int i, int j) const
+{
+    const auto& ci {clusters[i]};
+    const auto& cj {clusters[j]};
+    // If any of them is set not to merge, do not do that :)
+    if(!ci.GetToMerge() || !cj.GetToMerge())
+    {
+        if(fIsVerbose)
+            std::cout << "   i or j are set not to merge" << '\n';
+        return false;
+    }
+    // 0-> Reject clusters far apart
+    if(fMaxGap >= 0)
+    {
+        auto gap {GetGap(i, j)};
+        if(gap > fMaxGap)
+        {
+            if(fIsVerbose)
+                std::cout << "   gap > maxGap : " << gap << " > " << fMaxGap << '\n';
+            return false;
+        }
+    }
+    // 1-> Compare by distance from gravity point to line!
+    auto distI {ci.GetLine().DistanceLineToPoint(cj.GetLine().GetPoint())};
+    auto distJ {cj.GetLine().DistanceLineToPoint(ci.GetLine().GetPoint())};
+    auto dist {std::max(distI, distJ)};
+    bool isBelowThresh {dist <= fDistThresh};
+    // 2-> Compare by paralelity
+    bool areParallel {std::abs(fDirs[i].Dot(fDirs[j])) > fMinParallelFactor};
+    if(fIsVerbose)
+    {
+        std::cout << "   dist < distThres ? " << dist << " < " << fDistThresh << '\n';
+        std::cout << "   are parallel ? " << std::boolalpha << areParallel << '\n';
+    }
+    return isBelowThresh && areParallel;
+}
+
+bool ActAlgorithm::ClusterMerger::ImprovesFit(const std::vector<ActRoot::Cluster>& clusters, int i, int j) const
+{
+    // Fit of summed voxels, from the sum of moments of both clusters
+    ActRoot::Line sumLine {};
+    sumLine.FitMoments(fMoments[i] + fMoments[j]);
+    auto newChi2 {sumLine.GetChi2()};
+    // oldChi2 is obtained by quadratic sum of chi2s
+    auto oldChi2 {
+        std::sqrt(std::pow(clusters[i].GetLine().GetChi2(), 2) + std::pow(clusters[j].GetLine().GetChi2(), 2))};
+    bool improvesFit {newChi2 < fChi2Factor * oldChi2};
+    if(fIsVerbose)
+        std::cout << "   newChi2 < f * oldChi2 ? : " << newChi2 << " < " << fChi2Factor * oldChi2 << '\n';
+    return improvesFit;
+}
+
+void ActAlgorithm::ClusterMerger::Merge(std::vector<ActRoot::Cluster>& clusters, int i, int j)
+{
+    // Save in bigger cluster
+    // and delete smaller one
+    int save {clusters[i].GetSizeOfVoxels() > clusters[j].GetSizeOfVoxels() ? i : j};
+    int del {save == i ? j : i};
+    auto& saveCluster {clusters[save]};
+    auto& delCluster {clusters[del]};
+    auto& saveVoxels {saveCluster.GetRefToVoxels()};
+    auto& delVoxels {delCluster.GetRefToVoxels()};
+    saveVoxels.insert(saveVoxels.end(), std::make_move_iterator(delVoxels.begin()),
+                      std::make_move_iterator(delVoxels.end()));
+    // Refit and recompute ranges
+    saveCluster.ReFit();
+    saveCluster.ReFillSets();
+    // Update caches
+    fMoments[save] += fMoments[del];
+    fDirs[save] = saveCluster.GetLine().GetDirection().Unit();
+    for(int k = 0; k < 3; k++)
+    {
+        fBoxes[save][k].first = std::min(fBoxes[save][k].first, fBoxes[del][k].first);
+        fBoxes[save][k].second = std::max(fBoxes[save][k].second, fBoxes[del][k].second);
+    }
+    // Mark to delete afterwards!
+    fDeleted[del] = true;
+    if(fIsVerbose)
+    {
+        std::cout << "   => merge cluster #" << delCluster.GetClusterID() << " and size : " << delCluster.GetSizeOfVoxels()
+                  << '\n';
+        std::cout << "      with cluster #" << saveCluster.GetClusterID() << " and size : " << saveCluster.GetSizeOfVoxels()
+                  << '\n';
+    }
+}
+
+void ActAlgorithm::ClusterMerger::Run(std::vector<ActRoot::Cluster>& clusters)
+{
+    // Sort clusters by increasing voxel size
+    std::sort(clusters.begin(), clusters.end(), [](const ActRoot::Cluster& l, const ActRoot::Cluster& r)
+              { return l.GetSizeOfVoxels() < r.GetSizeOfVoxels(); });
+    if(fIsVerbose)
+        std::cout << BOLDYELLOW << "---- MergeSimilarClusters ----" << '\n';
+    Init(clusters);
+    // Run over ordered pairs: a pair is tried again if one of them grows in between
+    int size {static_cast<int>(clusters.size())};
+    for(int i = 0; i < size; i++)
+    {
+        // Stop as soon as i is merged into another cluster
+        for(int j = 0; j < size && !fDeleted[i]; j++)
+        {
+            // exclude comparison of same cluster and other already to be deleted
+            if(i == j || fDeleted[j])
+                continue;
+            if(fIsVerbose)
+                std::cout << "<i, j> : <" << i << ", " << j << ">" << '\n';
+            if(IsCandidate(clusters, i, j) && ImprovesFit(clusters, i, j))
+                Merge(clusters, i, j);
+        }
+    }
+    // Delete clusters in a single pass, keeping order
+    int n {};
+    for(int i = 0; i < size; i++)
+    {
+        if(fDeleted[i])
+            continue;
+        if(n != i)
+            clusters[n] = std::move(clusters[i]);
+        n++;
+    }
+    clusters.erase(clusters.begin() + n, clusters.end());
+    if(fIsVerbose)
+        std::cout << "------------------------------" << RESET << '\n';
+}
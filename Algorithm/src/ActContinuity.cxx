@@ -7,8 +7,14 @@
 #include "ActTPCParameters.h"
 #include "ActVCluster.h"
 #include "ActVoxel.h"
+#include "ActVoxelCloud.h"
+
+#include "TString.h"
+
+#include "BS_thread_pool.h"
 
 #include <algorithm>
+#include <future>
 #include <iostream>
 #include <numeric>
 #include <string>
@@ -16,6 +22,16 @@
 #include <utility>
 #include <vector>
 
+namespace
+{
+//! Pool shared by all Continuity instances. Size is fixed by the first caller
+BS::thread_pool& GetPool(int nthreads)
+{
+    static BS::thread_pool pool(nthreads > 0 ? nthreads : 0);
+    return pool;
+}
+} // namespace
+
 ActAlgorithm::Continuity::Continuity(ActRoot::TPCParameters* tpc, int minPoints) : VCluster(minPoints), fTPC(tpc)
 {
     InitMatrix();
@@ -25,6 +41,12 @@ void ActAlgorithm::Continuity::Print() const
 {
     std::cout << BOLDMAGENTA << ".... Continuity configuration ...." << '\n';
     std::cout << "-> MinPoints : " << fMinPoints << '\n';
+    std::cout << "-> Method    : " << (fUseUnionFind ? "UnionFind" : "BFS") << '\n';
+    if(fUseUnionFind)
+    {
+        std::cout << "-> Threads   : " << fNThreads << '\n';
+        std::cout << "-> MinParallelVoxels : " << fMinParallelVoxels << '\n';
+    }
     std::cout << "............................." << RESET << '\n';
 }
 
@@ -44,36 +66,102 @@ void ActAlgorithm::Continuity::ReadConfiguration()
     auto cb {parser.GetBlock("Continuity")};
     if(cb->CheckTokenExists("MinPoints"))
         fMinPoints = cb->GetInt("MinPoints");
+    if(cb->CheckTokenExists("Method", true))
+    {
+        TString method {cb->GetString("Method")};
+        method.ToLower();
+        if(method == "bfs")
+            fUseUnionFind = false;
+        else if(method == "unionfind")
+            fUseUnionFind = true;
+        else
+            throw std::runtime_error("Continuity::ReadConfiguration(): Method must be BFS or UnionFind");
+    }
+    if(cb->CheckTokenExists("Threads", true))
+        fNThreads = cb->GetInt("Threads");
+    if(cb->CheckTokenExists("MinParallelVoxels", true))
+        fMinParallelVoxels = cb->GetInt("MinParallelVoxels");
 }
 
 void ActAlgorithm::Continuity::InitMatrix()
 {
-    fMatrix = std::vector<std::vector<std::vector<int>>>(
-        fTPC->GetNPADSX(), std::vector<std::vector<int>>(fTPC->GetNPADSY(), std::vector<int>(fTPC->GetNPADSZ(), -1)));
+    fNX = fTPC->GetNPADSX();
+    fNY = fTPC->GetNPADSY();
+    fNZ = fTPC->GetNPADSZ();
+    // One bit per cell: only voxel indexes of occupied cells are stored, in fCellKeys
+    fOccupied.assign((static_cast<size_t>(fNX) * fNY * fNZ + 63) / 64, 0);
+    fCellKeys.clear();
+    fCellVoxels.clear();
 }
 
 void ActAlgorithm::Continuity::FillMatrix()
 {
-    for(int i = 0, size = fVoxels.size(); i < size; i++)
+    // Only the cells of previous event are cleared, so the cost does not depend on the pad plane
+    for(const auto& cell : fCellKeys)
+        if(cell != -1)
+            fOccupied[cell / 64] &= ~(1ULL << (cell % 64));
+    // Hash table at most half full
+    int size {fCloud.GetSize()};
+    fHashBits = 1;
+    while((1 << fHashBits) < 2 * size)
+        fHashBits++;
+    fCellKeys.assign(1 << fHashBits, -1);
+    fCellVoxels.resize(fCellKeys.size());
+    fHasDuplicates = false;
+    for(int i = 0; i < size; i++)
     {
         auto [x, y, z] {GetCoordinates(i)};
-        fMatrix[x][y][z] = i;
+        if(IsInCage(x, y, z))
+            SetVoxel(GetCell(x, y, z), i);
     }
 }
 
+int ActAlgorithm::Continuity::GetSlot(int cell) const
+{
+    // Fibonacci hashing of the cell, linear probing up to it or to an empty slot
+    auto mask {fCellKeys.size() - 1};
+    auto slot {static_cast<size_t>((static_cast<unsigned long long>(cell) * 0x9E3779B97F4A7C15ULL) >> (64 - fHashBits))};
+    while(fCellKeys[slot] != -1 && fCellKeys[slot] != cell)
+        slot = (slot + 1) & mask;
+    return static_cast<int>(slot);
+}
+
+int ActAlgorithm::Continuity::FindVoxel(int cell) const
+{
+    if(!(fOccupied[cell / 64] & (1ULL << (cell % 64))))
+        return -1;
+    return fCellVoxels[GetSlot(cell)];
+}
+
+void ActAlgorithm::Continuity::SetVoxel(int cell, int index)
+{
+    auto& word {fOccupied[cell / 64]};
+    auto bit {1ULL << (cell % 64)};
+    // Last voxel in a cell wins, as in the former dense matrix
+    if(word & bit)
+        fHasDuplicates = true;
+    word |= bit;
+    auto slot {GetSlot(cell)};
+    fCellKeys[slot] = cell;
+    fCellVoxels[slot] = index;
+}
+
 std::tuple<int, int, int> ActAlgorithm::Continuity::GetCoordinates(int index)
 {
-    const auto& pos {fVoxels[index].GetPosition()};
-    auto x {(int)pos.X()};
-    auto y {(int)pos.Y()};
-    auto z {(int)pos.Z()};
+    auto x {(int)fCloud.GetX()[index]};
+    auto y {(int)fCloud.GetY()[index]};
+    auto z {(int)fCloud.GetZ()[index]};
     return {x, y, z};
 }
 
 void ActAlgorithm::Continuity::MaskVoxelsInMatrix(int index)
 {
     auto [x, y, z] {GetCoordinates(index)};
-    fMatrix[x][y][z] = -1;
+    if(!IsInCage(x, y, z))
+        return;
+    // Slot in hash table is kept: FindVoxel tests the bit first
+    auto cell {GetCell(x, y, z)};
+    fOccupied[cell / 64] &= ~(1ULL << (cell % 64));
 }
 
 void ActAlgorithm::Continuity::MaskVoxelsInIndex(int index)
@@ -83,9 +171,9 @@ void ActAlgorithm::Continuity::MaskVoxelsInIndex(int index)
 template <typename T>
 bool ActAlgorithm::Continuity::IsInCage(T x, T y, T z)
 {
-    bool condX {0 <= x && x < fTPC->GetNPADSX()};
-    bool condY {0 <= y && y < fTPC->GetNPADSY()};
-    bool condZ {0 <= z && z < fTPC->GetNPADSZ()};
+    bool condX {0 <= x && x < fNX};
+    bool condY {0 <= y && y < fNY};
+    bool condZ {0 <= z && z < fNZ};
     return condX && condY && condZ;
 }
 
@@ -103,11 +191,9 @@ std::vector<int> ActAlgorithm::Continuity::ScanNeighborhood(const std::vector<in
                 {
                     if(ix == 0 && iy == 0 && iz == 0) // skip self point
                         continue;
-                    int index {};
-                    if(IsInCage(x + ix, y + iy, z + iz))
-                        index = fMatrix[x + ix][y + iy][z + iz];
-                    else
+                    if(!IsInCage(x + ix, y + iy, z + iz))
                         continue;
+                    auto index {FindVoxel(GetCell(x + ix, y + iy, z + iz))};
                     if(index != -1)
                     {
                         gen1.push_back(index);
@@ -127,11 +213,20 @@ void ActAlgorithm::Continuity::InitIndexes()
     // Clear
     fIndexes.clear();
     // Allocate enough memory
-    fIndexes.reserve(fVoxels.size());
+    fIndexes.reserve(fCloud.GetSize());
     // Set size
-    fIndexes.resize(fVoxels.size());
+    fIndexes.resize(fCloud.GetSize());
     // Fill
     std::iota(fIndexes.begin(), fIndexes.end(), 0);
+    fCursor = 0;
+}
+
+int ActAlgorithm::Continuity::NextSeed()
+{
+    // Voxels are only ever masked, so the cursor never moves back: linear over the whole event
+    while(fCursor < fIndexes.size() && fIndexes[fCursor] == -1)
+        fCursor++;
+    return (fCursor < fIndexes.size()) ? fIndexes[fCursor] : -1;
 }
 
 ActAlgorithm::VCluster::ClusterRet
@@ -140,29 +235,36 @@ ActAlgorithm::Continuity::Run(const std::vector<ActRoot::Voxel>& voxels, bool ad
     // Inner timer
     fClock.Start(false);
 
-    fVoxels = voxels; // copy in internal variable to avoid modifications
+    // Voxels are copied only when they are added to a cluster
+    fVoxels = &voxels;
+    fCloud.Assign(voxels);
     // Init Indexes structure
     InitIndexes();
     // Fill matrix
     FillMatrix();
+    // Voxels sharing a cell are hidden from BFS in an order-dependent way: keep BFS for them
+    if(fUseUnionFind && !fHasDuplicates)
+    {
+        auto ret {RunUnionFind(addNoise)};
+        fVoxels = nullptr;
+        fClock.Stop();
+        return ret;
+    }
     // Prepare return values:
     // Clusters (c)
     std::vector<ActRoot::Cluster> cret;
     // Noise (n)
     std::vector<ActRoot::Voxel> nret;
-    // Getter of seed based on fIndex being masked (=-1)
-    auto lambda {[](const int& i) { return i == -1; }};
-    auto it {std::find_if_not(fIndexes.begin(), fIndexes.end(), lambda)};
-    while(it != fIndexes.end()) //(fVoxels.size() > 0)
+    // Seed is the first non-masked (!= -1) element of fIndexes
+    for(int seed = NextSeed(); seed != -1; seed = NextSeed())
     {
-        // 1->Set seed of cluster as first non-masked element of fIndexes
-        auto seed {*it};
+        // 1->Set seed of cluster
         // Mask it!
         MaskVoxelsInMatrix(seed);
         MaskVoxelsInIndex(seed);
         // 2-> Create current cluster
         ActRoot::Cluster currentCluster {static_cast<int>(cret.size())};
-        currentCluster.AddVoxel(std::move(fVoxels[seed]));
+        currentCluster.AddVoxel((*fVoxels)[seed]);
         // 3-> Initialize generation 0
         std::vector<int> gen0 {seed};
         // 4-> Loop until no new neighbors are found!
@@ -176,7 +278,7 @@ ActAlgorithm::Continuity::Run(const std::vector<ActRoot::Voxel>& voxels, bool ad
             //              throw std::runtime_error("gen0 == gen1 at some point");
             // Push back voxels and indexes
             for(const auto& index : gen1)
-                currentCluster.AddVoxel(std::move(fVoxels[index]));
+                currentCluster.AddVoxel((*fVoxels)[index]);
             // Set gen0 to new iteration!
             gen0 = gen1;
         }
@@ -196,10 +298,200 @@ ActAlgorithm::Continuity::Run(const std::vector<ActRoot::Voxel>& voxels, bool ad
                     nret.push_back(std::move(voxel));
             }
         }
-        // Prepare iterator for next iteration
-        it = std::find_if_not(fIndexes.begin(), fIndexes.end(), lambda);
     }
-    fVoxels.clear();
+    fVoxels = nullptr;
     fClock.Stop();
     return std::make_pair(std::move(cret), std::move(nret));
 }
+
+bool ActAlgorithm::Continuity::IsOccupant(int index)
+{
+    auto [x, y, z] {GetCoordinates(index)};
+    return IsInCage(x, y, z) && FindVoxel(GetCell(x, y, z)) == index;
+}
+
+int ActAlgorithm::Continuity::FindRoot(int index)
+{
+    // Path halving
+    while(fParents[index] != index)
+    {
+        fParents[index] = fParents[fParents[index]];
+        index = fParents[index];
+    }
+    return index;
+}
+
+void ActAlgorithm::Continuity::Unite(int a, int b)
+{
+    auto ra {FindRoot(a)};
+    auto rb {FindRoot(b)};
+    // Root is always the lowest index of the component
+    if(ra < rb)
+        fParents[rb] = ra;
+    else if(rb < ra)
+        fParents[ra] = rb;
+}
+
+void ActAlgorithm::Continuity::LabelSlab(int slab, int zmax)
+{
+    // Only unions between voxels of this slab are done here, so the parents written by
+    // each task are disjoint and no locking is needed. Edges to next slab are stored
+    auto& boundary {fBoundaries[slab]};
+    for(const auto& i : fSlabs[slab])
+    {
+        auto [x, y, z] {GetCoordinates(i)};
+        // Forward half of the neighbourhood: each edge is visited once
+        for(int iz = 0; iz <= 1; iz++)
+        {
+            for(int iy = -1; iy <= 1; iy++)
+            {
+                for(int ix = -1; ix <= 1; ix++)
+                {
+                    if(iz == 0 && (iy < 0 || (iy == 0 && ix <= 0)))
+                        continue;
+                    if(!IsInCage(x + ix, y + iy, z + iz))
+                        continue;
+                    auto j {FindVoxel(GetCell(x + ix, y + iy, z + iz))};
+                    if(j == -1)
+                        continue;
+                    if(z + iz < zmax)
+                        Unite(i, j);
+                    else
+                        boundary.push_back({i, j});
+                }
+            }
+        }
+    }
+}
+
+void ActAlgorithm::Continuity::LabelComponents()
+{
+    int size {fCloud.GetSize()};
+    fParents.resize(size);
+    std::iota(fParents.begin(), fParents.end(), 0);
+    // Number of slabs
+    int nslabs {1};
+    if(size >= fMinParallelVoxels)
+        nslabs = std::min(static_cast<int>(GetPool(fNThreads).get_thread_count()), fNZ);
+    auto lower = [&](int slab) { return static_cast<int>(static_cast<long long>(slab) * fNZ / nslabs); };
+    fSlabs.resize(nslabs);
+    fBoundaries.resize(nslabs);
+    for(int s = 0; s < nslabs; s++)
+    {
+        fSlabs[s].clear();
+        fBoundaries[s].clear();
+    }
+    for(int i = 0; i < size; i++)
+    {
+        if(!IsOccupant(i))
+            continue;
+        auto z {std::get<2>(GetCoordinates(i))};
+        fSlabs[static_cast<long long>(z) * nslabs / fNZ].push_back(i);
+    }
+    // Label each slab
+    if(nslabs == 1)
+        LabelSlab(0, fNZ);
+    else
+    {
+        std::vector<std::future<void>> tasks;
+        for(int s = 0; s < nslabs; s++)
+            tasks.push_back(GetPool(fNThreads).submit_task([this, s, &lower] { LabelSlab(s, lower(s + 1)); }));
+        for(auto& task : tasks)
+            task.get();
+    }
+    // And merge labels at boundaries
+    for(const auto& boundary : fBoundaries)
+        for(const auto& [a, b] : boundary)
+            Unite(a, b);
+}
+
+ActAlgorithm::VCluster::ClusterRet ActAlgorithm::Continuity::RunUnionFind(bool addNoise)
+{
+    LabelComponents();
+    int size {fCloud.GetSize()};
+    // Members of each component, by root, in increasing index (CSR layout)
+    std::vector<int> offsets(size + 1, 0);
+    std::vector<char> occupant(size);
+    for(int i = 0; i < size; i++)
+    {
+        occupant[i] = IsOccupant(i);
+        if(occupant[i])
+            offsets[FindRoot(i) + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<int> members(offsets.back());
+    {
+        auto fill {offsets};
+        for(int i = 0; i < size; i++)
+            if(occupant[i])
+                members[fill[FindRoot(i)]++] = i;
+    }
+    // Reproduce the seeding of BFS: the lowest index not yet clustered opens a cluster,
+    // which takes whole components
+    std::vector<char> taken(size);
+    ClusterRet ret;
+    auto take = [&](ActRoot::Cluster& cluster, int root)
+    {
+        taken[root] = true;
+        for(int m = offsets[root]; m < offsets[root + 1]; m++)
+            cluster.AddVoxel((*fVoxels)[members[m]]);
+    };
+    for(int i = 0; i < size; i++)
+    {
+        ActRoot::Cluster currentCluster {static_cast<int>(ret.first.size())};
+        if(occupant[i])
+        {
+            // Not the lowest index of its component: already clustered
+            if(taken[FindRoot(i)])
+                continue;
+            take(currentCluster, FindRoot(i));
+        }
+        else
+        {
+            // Outside the matrix: it only joins the components of its neighbours
+            currentCluster.AddVoxel((*fVoxels)[i]);
+            auto [x, y, z] {GetCoordinates(i)};
+            for(int ix = -1; ix <= 1; ix++)
+            {
+                for(int iy = -1; iy <= 1; iy++)
+                {
+                    for(int iz = -1; iz <= 1; iz++)
+                    {
+                        if(ix == 0 && iy == 0 && iz == 0)
+                            continue;
+                        if(!IsInCage(x + ix, y + iy, z + iz))
+                            continue;
+                        auto j {FindVoxel(GetCell(x + ix, y + iy, z + iz))};
+                        if(j == -1)
+                            continue;
+                        auto root {FindRoot(j)};
+                        if(!taken[root])
+                            take(currentCluster, root);
+                    }
+                }
+            }
+        }
+        AddCluster(currentCluster, ret, addNoise);
+    }
+    return ret;
+}
+
+void ActAlgorithm::Continuity::AddCluster(ActRoot::Cluster& cluster, ClusterRet& ret, bool addNoise)
+{
+    // Check whether to validate cluster or not
+    // based on number of voxels
+    if(cluster.GetSizeOfVoxels() > fMinPoints)
+    {
+        // Of course, fit it before pushing
+        cluster.ReFit();
+        ret.first.push_back(std::move(cluster));
+    }
+    else
+    {
+        if(addNoise)
+        {
+            for(auto& voxel : cluster.GetRefToVoxels())
+                ret.second.push_back(std::move(voxel));
+        }
+    }
+}
@@ -93,6 +93,18 @@ void ActAlgorithm::MultiAction::ReadConfiguration()
     // And init!
     for(const auto& header : headers)
     {
+        // Profiling settings are not an action
+        if(header == "Profiling")
+        {
+            auto block {parser.GetBlock(header)};
+            if(block->CheckTokenExists("IsEnabled", true))
+                fProfile = block->GetBool("IsEnabled");
+            if(block->CheckTokenExists("SlowestN", true))
+                fProfiler.SetNSlowest(block->GetInt("SlowestN"));
+            if(block->CheckTokenExists("File", true))
+                fProfileFile = block->GetString("File");
+            continue;
+        }
         // User actions, containing [User] word in their header names
         if(header.find("User") != std::string::npos)
         {
@@ -118,17 +130,36 @@ void ActAlgorithm::MultiAction::ReadConfiguration()
         // And set pointer to THIS MultiAction manager class
         fActions.back()->SetMultiAction(this);
     }
+    // Init profiler with action names
+    std::vector<std::string> names;
+    for(const auto& action : fActions)
+        names.push_back(action->GetActionID());
+    fProfiler.Init(names);
 }
 
 void ActAlgorithm::MultiAction::Run()
 {
-    fTimer.Start(false);
-    for(auto& action : fActions)
+    if(!fProfile)
+    {
+        for(auto& action : fActions)
+        {
+            action->Run();
+            ResetClusterID();
+        }
+        return;
+    }
+    auto in {GetNClusteredVoxels()};
+    fProfiler.StartEvent(fRun, fEntry, in);
+    for(int i = 0, size = fActions.size(); i < size; i++)
     {
-        action->Run();
+        auto start {ActionProfiler::Clock::now()};
+        fActions[i]->Run();
         ResetClusterID();
+        auto out {GetNClusteredVoxels()};
+        fProfiler.AddAction(i, start, in, out);
+        in = out;
     }
-    fTimer.Stop();
+    fProfiler.EndEvent(in);
 }
 
 void ActAlgorithm::MultiAction::Print() const
@@ -139,9 +170,20 @@ void ActAlgorithm::MultiAction::Print() const
 
 void ActAlgorithm::MultiAction::PrintReports() const
 {
-    std::cout << BOLDYELLOW << "···· MultiAction time report ····" << '\n';
-    fTimer.Print();
-    std::cout << "······························" << RESET << '\n';
+    if(!fProfile)
+        return;
+    fProfiler.Print();
+    if(fProfileFile.length())
+        fProfiler.Write(fProfileFile);
+}
+
+bool ActAlgorithm::MultiAction::MergeReports(const VFilter& other)
+{
+    auto* ma {dynamic_cast<const MultiAction*>(&other)};
+    if(!ma || !fProfile)
+        return false;
+    fProfiler.Merge(ma->fProfiler);
+    return true;
 }
 
 void ActAlgorithm::MultiAction::ResetClusterID()
@@ -150,6 +192,14 @@ void ActAlgorithm::MultiAction::ResetClusterID()
         fData->fClusters[i].SetClusterID(i);
 }
 
+int ActAlgorithm::MultiAction::GetNClusteredVoxels() const
+{
+    int n {};
+    for(const auto& cluster : fData->fClusters)
+        n += cluster.GetSizeOfVoxels();
+    return n;
+}
+
 void ActAlgorithm::MultiAction::LoadUserAction(std::shared_ptr<ActRoot::InputBlock> block)
 {
     // Get name
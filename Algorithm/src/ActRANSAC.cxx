@@ -7,13 +7,16 @@
 #include "ActOptions.h"
 #include "ActVCluster.h"
 #include "ActVoxel.h"
+#include "ActVoxelCloud.h"
 
-#include "TMath.h"
 #include "TRandom.h"
 
+#include <algorithm>
+#include <cmath>
 #include <ios>
 #include <iostream>
 #include <iterator>
+#include <numeric>
 #include <set>
 #include <string>
 #include <utility>
@@ -41,31 +44,92 @@ void ActAlgorithm::RANSAC::ReadConfiguration()
         fIterations = rb->GetInt("Iterations");
     if(rb->CheckTokenExists("UseLmeds", true))
         fUseLmeds = rb->GetBool("UseLmeds");
+    if(rb->CheckTokenExists("Adaptive", true))
+        fAdaptive = rb->GetBool("Adaptive");
+    if(rb->CheckTokenExists("Confidence", true))
+        fConfidence = rb->GetDouble("Confidence");
+    if(rb->CheckTokenExists("PreemptiveSize", true))
+        fPreemptiveSize = rb->GetInt("PreemptiveSize");
 }
 
-int ActAlgorithm::RANSAC::GetNInliers(const std::vector<ActRoot::Voxel>& voxels, ActRoot::Line& line)
+void ActAlgorithm::RANSAC::FillCoordinates(const std::vector<ActRoot::Voxel>& voxels)
 {
-    int ninliers {};
-    std::vector<double> verrors;
-    for(const auto& voxel : voxels)
+    int size {static_cast<int>(voxels.size())};
+    // Preemptive scoring uses the first voxels: shuffle so they are a random subset
+    if(fAdaptive && fPreemptiveSize > 0 && size > fPreemptiveSize)
     {
-        const auto& pos = voxel.GetPosition();
-        double err = line.DistanceLineToPoint(pos);
-        err *= err;
-        if(err < (fDistThreshold * fDistThreshold))
+        fOrder.resize(size);
+        std::iota(fOrder.begin(), fOrder.end(), 0);
+        auto* rand {GetRandom()};
+        for(int i = size - 1; i > 0; i--)
         {
-            verrors.push_back(err);
-            ninliers++;
+            int j {static_cast<int>(rand->Integer(i + 1))};
+            std::swap(fOrder[i], fOrder[j]);
         }
+        fCloud.Assign(voxels, fOrder);
     }
+    else
+        fCloud.Assign(voxels);
+}
+
+int ActAlgorithm::RANSAC::CountInliers(const ActRoot::Line& line, int begin, int end) const
+{
+    const auto& point {line.GetPoint()};
+    const auto& dir {line.GetDirection()};
+    float px {point.X()}, py {point.Y()}, pz {point.Z()};
+    float dx {dir.X()}, dy {dir.Y()}, dz {dir.Z()};
+    // dist^2 = |dir x (p - point)|^2 / |dir|^2: compare without division
+    float thresh2 {static_cast<float>(fDistThreshold * fDistThreshold) * (dx * dx + dy * dy + dz * dz)};
+    const float* x {fCloud.GetX()};
+    const float* y {fCloud.GetY()};
+    const float* z {fCloud.GetZ()};
+    // Branchless body over contiguous arrays, so the compiler vectorizes it
+    int count {};
+    for(int i = begin; i < end; i++)
+    {
+        float vx {x[i] - px};
+        float vy {y[i] - py};
+        float vz {z[i] - pz};
+        float cx {dy * vz - dz * vy};
+        float cy {dz * vx - dx * vz};
+        float cz {dx * vy - dy * vx};
+        count += (cx * cx + cy * cy + cz * cz) < thresh2;
+    }
+    return count;
+}
+
+int ActAlgorithm::RANSAC::GetNInliers(ActRoot::Line& line)
+{
     // Naive implementation of other estimators simply changing the test value
     if(fUseLmeds)
     {
-        double weight {TMath::Median(verrors.size(), &(verrors[0]))};
+        // Squared errors of inliers
+        fErrors.clear();
+        double thresh2 {fDistThreshold * fDistThreshold};
+        for(int i = 0, size = fCloud.GetSize(); i < size; i++)
+        {
+            double err {line.DistanceLineToPoint(fCloud.GetPosition(i))};
+            err *= err;
+            if(err < thresh2)
+                fErrors.push_back(err);
+        }
+        // Median as in TMath::Median, without allocations
+        double weight {};
+        if(auto n {fErrors.size()}; n > 0)
+        {
+            auto mid {fErrors.begin() + n / 2};
+            std::nth_element(fErrors.begin(), mid, fErrors.end());
+            weight = *mid;
+            if(n % 2 == 0)
+                weight = 0.5 * (weight + *std::max_element(fErrors.begin(), mid));
+        }
+        // Inliers counted with the same double precision test as the errors
+        int ninliers {static_cast<int>(fErrors.size())};
         line.SetChi2(weight / ninliers);
+        return ninliers;
     }
-    else
-        line.SetChi2(1. / ninliers);
+    int ninliers {CountInliers(line, 0, fCloud.GetSize())};
+    line.SetChi2(1. / ninliers);
     return ninliers;
 }
 
@@ -116,7 +180,7 @@ ActRoot::Line ActAlgorithm::RANSAC::SampleLine(const std::vector<ActRoot::Voxel>
     std::vector<ActRoot::Voxel> picked;
     while(idxs.size() < 2) // Line = 2 points
     {
-        int i {static_cast<int>(gRandom->Uniform() * voxels.size())};
+        int i {static_cast<int>(GetRandom()->Uniform() * voxels.size())};
         if(!IsInVector(i, idxs))
         {
             idxs.push_back(i);
@@ -139,17 +203,50 @@ ActAlgorithm::VCluster::ClusterRet ActAlgorithm::RANSAC::Run(const std::vector<A
     // Build set to compare lines
     auto lambdaCompare = [](const ActRoot::Line& a, const ActRoot::Line& b) { return a.GetChi2() < b.GetChi2(); };
     std::set<ActRoot::Line, decltype(lambdaCompare)> sortedLines(lambdaCompare);
-    // 1-> Run for fIterations
-    for(int i = 0; i < fIterations; i++)
+    FillCoordinates(voxels);
+    int size {static_cast<int>(voxels.size())};
+    bool preemptive {fAdaptive && fPreemptiveSize > 0 && size > fPreemptiveSize};
+    // Expected inliers in the subset of a line with exactly fMinPoints inliers
+    double minInSubset {preemptive ? static_cast<double>(fMinPoints) * fPreemptiveSize / size : 0};
+    // Iterations needed to sample with fConfidence the smallest accepted line, with fMinPoints inliers.
+    // Not updated with the best line found: a dominant beam would stop the search before sampling
+    // the shorter tracks of the reaction products
+    int needed {fIterations};
+    if(fAdaptive)
+    {
+        double w {static_cast<double>(fMinPoints) / size};
+        double pfail {1 - w * w};
+        if(pfail <= 0)
+            needed = 1;
+        else
+        {
+            // Compare as double: n overflows an int for very small w
+            double n {std::ceil(std::log(1 - fConfidence) / std::log(pfail))};
+            if(n < fIterations)
+                needed = std::max(1, static_cast<int>(n));
+        }
+    }
+    // 1-> Run for fIterations (or less if adaptive)
+    int i {};
+    for(; i < needed; i++)
     {
         // 1->Sample line
         auto sampled {SampleLine(voxels)};
-        // 2->Get inliers of line
-        auto inliers {GetNInliers(voxels, sampled)};
-        // 3-> If ninliers greater than minimum, push to set of lines
+        // 2->Score on subset first: reject if even a 3 sigma fluctuation could not reach minimum
+        if(preemptive)
+        {
+            double partial {static_cast<double>(CountInliers(sampled, 0, fPreemptiveSize))};
+            if(partial + 3 * std::sqrt(partial + 1) < minInSubset)
+                continue;
+        }
+        // 3->Get inliers of line
+        auto inliers {GetNInliers(sampled)};
+        // 4-> If ninliers greater than minimum, push to set of lines
         if(inliers > fMinPoints)
             sortedLines.insert(sampled);
     }
+    fNRuns++;
+    fNIters += i;
     // 2-> Extract points from cloud belonging to the best scored lines
     auto remain = voxels; // copy to avoid modification of init vector
     for(const auto& line : sortedLines)
@@ -178,6 +275,12 @@ void ActAlgorithm::RANSAC::Print() const
     std::cout << "-> MinPoints    : " << fMinPoints << '\n';
     std::cout << "-> Iterations   : " << fIterations << '\n';
     std::cout << "-> UseLmeds     : " << std::boolalpha << fUseLmeds << '\n';
+    std::cout << "-> Adaptive     : " << std::boolalpha << fAdaptive << '\n';
+    if(fAdaptive)
+    {
+        std::cout << "-> Confidence   : " << fConfidence << '\n';
+        std::cout << "-> PreemptiveSize : " << fPreemptiveSize << '\n';
+    }
     std::cout << "===========================" << RESET << '\n';
 }
 
@@ -185,5 +288,7 @@ void ActAlgorithm::RANSAC::PrintReports() const
 {
     std::cout << BOLDYELLOW << "==== RANSAC time report ====" << '\n';
     fClock.Print();
+    if(fNRuns > 0)
+        std::cout << "-> Mean iterations : " << static_cast<double>(fNIters) / fNRuns << '\n';
     std::cout << "==============================" << RESET << '\n';
 }
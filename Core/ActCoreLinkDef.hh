@@ -18,9 +18,13 @@
 #pragma link C++ enum ActRoot::ModeType + ;
 
 // data manager, inputs and outputs
+#pragma link C++ class ActRoot::AsyncWriter;
 #pragma link C++ class ActRoot::DataManager;
 #pragma link C++ class ActRoot::InputData;
+#pragma link C++ class ActRoot::InputPrefetcher;
 #pragma link C++ class ActRoot::OutputData;
+#pragma link C++ class ActRoot::RandomStream;
+#pragma link C++ class ActRoot::ParallelOutputData;
 
 // options manager
 #pragma link C++ class ActRoot::Options;
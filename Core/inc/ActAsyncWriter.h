@@ -0,0 +1,89 @@
+#ifndef ActAsyncWriter_h
+#define ActAsyncWriter_h
+
+#include "TClass.h"
+#include "TTree.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ActRoot
+{
+//! Hands filled output objects to a dedicated thread that runs TTree::Fill (and basket compression)
+/*!
+  Top-level branches of the output tree are redirected to internal addresses. On Push,
+  the objects the detectors filled are swapped with free ones of a bounded pool and queued;
+  the writer thread then sets them in the tree and calls the fill function. Detectors always
+  clear their data before building an event, so reusing objects is safe.
+  Only top-level object branches (TBranchElement) are supported
+*/
+class AsyncWriter
+{
+public:
+    //! Counters to compare reconstruction and compression costs
+    class Stats
+    {
+    public:
+        unsigned long fNFilled {};
+        unsigned long fStalls {}; //!< Queue was full when pushing: writer-bound
+        double fFillTime {};      //!< Real time spent by writer thread in Fill
+        double fBusyTime {};      //!< Real time of producer not blocked in Push
+        unsigned int fDepth {};
+
+        void Add(const Stats& other);
+        double GetRatio() const { return fFillTime > 0 ? fBusyTime / fFillTime : 0; }
+        void Print() const;
+    };
+
+private:
+    class Slot
+    {
+    public:
+        std::vector<void*> fObjects {};
+    };
+
+    TTree* fTree {};
+    std::function<void()> fFill {};
+    std::vector<std::string> fBranchNames {};
+    std::vector<void**> fUserAddresses {};
+    std::vector<TClass*> fClasses {};
+    std::vector<void*> fStaging {}; //!< Addresses registered in fTree
+
+    std::vector<Slot> fSlots {};
+    std::deque<int> fReady {};
+    std::deque<int> fFree {};
+    bool fStop {};
+    int fNInFlight {}; //!< Slots popped by writer but not filled yet
+    std::thread fThread {};
+    std::mutex fMutex {};
+    std::condition_variable fCV {};
+    std::chrono::steady_clock::time_point fStart {};
+    std::chrono::steady_clock::duration fStallTime {}; //!< Producer blocked in Push or Flush
+    Stats fStats {};
+
+public:
+    AsyncWriter(TTree* tree, int depth, std::function<void()> fill = {});
+    ~AsyncWriter();
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    // Queue current content of output objects
+    void Push();
+    // Wait until every queued entry has been filled
+    void Flush();
+
+    const Stats& GetStats() const { return fStats; }
+
+private:
+    void InitBranches();
+    void Write();
+};
+} // namespace ActRoot
+
+#endif
@@ -31,6 +31,11 @@ private:
     std::vector<std::vector<double>> fPadAlign; //!< Pad align coefficiens
     std::vector<std::string> fFiles;            //!< List of files read in calibration
     bool fIsEnabled {true};                     //!< Whether to enable or not when calling ApplyCalibration/Threshold
+    // Compiled tables: keys resolved once to dense handles
+    std::unordered_map<std::string, int> fHandles; //!< Key to handle
+    std::vector<std::string> fHandleKeys;          //!< Handle to key
+    std::vector<std::pair<int, int>> fTables;      //!< Handle to {begin, size} in fCoeffs. Size 0 if not calibrated
+    std::vector<double> fCoeffs;                   //!< Coefficients of all handles, contiguous
 
 public:
     CalibrationManager() = default;                 //<! Default constructor
@@ -43,12 +48,19 @@ public:
     void ReadInvertedLookUpTable(const std::string& file);
     void ReadPadAlign(const std::string& file);
 
-    // Apply methods
-    double ApplyCalibration(const std::string& key, double raw);
-    bool ApplyThreshold(const std::string& key, double raw, double nsigma = 1);
-    int ApplyLookUp(int channel, int col);
-    std::tuple<int, int, int, int> ApplyInvLookUp(int x, int y);
-    double ApplyPadAlignment(int channel, double q);
+    // Resolve key to handle for the Apply methods below. Keys not (yet) read are valid handles too:
+    // tables are recompiled each time a calibration file is read.
+    // Registering a new key modifies the tables: do it before sharing the manager among threads
+    int GetHandle(const std::string& key);
+
+    // Apply methods: read-only, so a single instance can be shared by several threads
+    double ApplyCalibration(const std::string& key, double raw) const;
+    bool ApplyThreshold(const std::string& key, double raw, double nsigma = 1) const;
+    double ApplyCalibration(int handle, double raw) const;
+    bool ApplyThreshold(int handle, double raw, double nsigma = 1) const;
+    int ApplyLookUp(int channel, int col) const;
+    std::tuple<int, int, int, int> ApplyInvLookUp(int x, int y) const;
+    double ApplyPadAlignment(int channel, double q) const;
 
     // Setters
     void SetIsEnabled(bool enabled) { fIsEnabled = enabled; }
@@ -57,6 +69,10 @@ public:
     bool GetIsEnabled() const { return fIsEnabled; }
 
     void Print() const;
+
+private:
+    void Compile();
+    double EvalPolynomial(const double* coeffs, int size, double x) const;
 };
 } // namespace ActRoot
 
@@ -4,14 +4,17 @@
 #include "ActInputData.h"
 #include "ActInputParser.h"
 #include "ActOutputData.h"
+#include "ActParallelOutputData.h"
 #include "ActTypes.h"
 
 #include "TChain.h"
 
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace ActRoot
 {
@@ -22,6 +25,9 @@ private:
     std::set<int> fRuns {};
     std::set<int> fExludeList {};
     std::string fManual {};
+    int fPrefetch {};     //!< Depth of read-ahead queue of InputData
+    double fCacheSize {}; //!< TTreeCache size in MB of InputData
+    int fAsyncWrite {};   //!< Depth of writer queue of OutputData
     ModeType fMode {ModeType::ENone};
 
 public:
@@ -40,6 +46,13 @@ public:
     OutputData GetOuput() { return GetOuput(fMode); };
     OutputData GetOuput(ModeType mode);
     OutputData GetOutputForThread(const std::set<int>& runs);
+    ParallelOutputData GetParallelOutput(const std::map<int, int>& chunksPerRun)
+    {
+        return GetParallelOutput(chunksPerRun, fMode);
+    }
+    ParallelOutputData GetParallelOutput(const std::map<int, int>& chunksPerRun, ModeType mode);
+    // Modes of the outputs written by the current mode (more than one for ReadAll)
+    std::vector<ModeType> GetOutputModes() const;
 
     std::shared_ptr<TChain> GetJoinedData() { return GetJoinedData(fMode); };
     std::shared_ptr<TChain> GetJoinedData(ModeType mode);
@@ -2,6 +2,7 @@
 #define ActInputData_h
 
 #include "ActInputParser.h"
+#include "ActInputPrefetcher.h"
 
 #include "TChain.h"
 #include "TFile.h"
@@ -29,6 +30,11 @@ private:
     std::map<int, std::vector<int>> fManualEntries {};
     // Local copy of runs from DataManager
     std::set<int> fRuns {};
+    // Optional read-ahead stage
+    int fPrefetchDepth {};  //!< Size of queue of decoded entries. 0 disables prefetching
+    long long fCacheSize {}; //!< Size of TTreeCache in bytes. <= 0 keeps ROOT's default
+    std::map<int, std::shared_ptr<InputPrefetcher>> fPrefetchers {};
+    InputPrefetcher::Stats fPrefetchStats {}; //!< Accumulated over closed runs
 
 public:
     InputData() = default;
@@ -44,6 +50,11 @@ public:
 
     void InitChain(const std::set<int>& runs);
 
+    // Enable background read-ahead of depth entries, read with a TTreeCache of cacheSize MB
+    void SetPrefetch(int depth, double cacheSize = 0);
+    const InputPrefetcher::Stats& GetPrefetchStats() const { return fPrefetchStats; }
+    void PrintPrefetchStats() const;
+
     // Getters
     std::map<int, std::shared_ptr<TTree>> GetTrees() const { return fTrees; }
     std::shared_ptr<TTree> GetTree(int run) const { return fTrees.at(run); }
@@ -61,6 +72,8 @@ private:
     void CheckFileExists(const std::string& file);
     void CheckTreeExists(std::shared_ptr<TTree> tree, int i);
     std::string SolveRelativePath(const std::string& path);
+    std::string GetFileName(int in, int run) const;
+    std::shared_ptr<InputPrefetcher> InitPrefetcher(int run);
 };
 } // namespace ActRoot
 #endif
@@ -0,0 +1,99 @@
+#ifndef ActInputPrefetcher_h
+#define ActInputPrefetcher_h
+
+#include "TClass.h"
+#include "TFile.h"
+#include "TTree.h"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ActRoot
+{
+//! Background read-ahead stage for a tree whose branch addresses are set by the detectors
+/*!
+  A reader thread reads entries of its own copy of the tree (reopened files, same friends
+  and branch statuses) into a bounded queue of decoded objects. When the consumer asks for
+  the next entry, the pointers registered by the detectors with SetBranchAddress are swapped
+  with the ones of the queued entry, so no copy is done. Baskets of the copy are read through
+  a TTreeCache restricted to the branches the detectors actually use.
+  Only top-level object branches (TBranchElement) are supported
+*/
+class InputPrefetcher
+{
+public:
+    //! Counters to assess whether a job is I/O- or CPU-bound
+    class Stats
+    {
+    public:
+        unsigned long fNServed {};       //!< Entries served from the queue
+        unsigned long fNRestarts {};     //!< Non-sequential requests that restarted the reader
+        unsigned long fConsumerStalls {}; //!< Consumer found the queue empty: I/O-bound
+        unsigned long fProducerStalls {}; //!< Reader found the queue full: CPU-bound
+        unsigned long fDepthSum {};      //!< Sum of queue depth seen by consumer, to compute the average
+        unsigned int fDepth {};          //!< Capacity of the queue
+
+        void Add(const Stats& other);
+        double GetAverageDepth() const { return fNServed ? (double)fDepthSum / fNServed : 0; }
+        void Print() const;
+    };
+
+private:
+    class Slot
+    {
+    public:
+        std::vector<void*> fObjects {};
+    };
+
+    // Tree of the consumer (whose addresses are swapped)
+    TTree* fUser {};
+    std::vector<void**> fUserAddresses {};
+    std::vector<TClass*> fClasses {};
+    std::vector<std::string> fBranchNames {};
+    // Copy of the tree read by the background thread
+    std::shared_ptr<TFile> fFile {};
+    std::shared_ptr<TTree> fTree {};
+    std::vector<void*> fStaging {}; //!< Addresses registered in fTree
+
+    // Queue
+    std::vector<Slot> fSlots {};
+    std::deque<int> fReady {};
+    std::deque<int> fFree {};
+    int fNext {};     //!< Next entry to be read by the reader
+    int fExpected {}; //!< Next entry the consumer is expected to request
+    int fEnd {};
+    bool fStop {};
+    std::thread fThread {};
+    std::mutex fMutex {};
+    std::condition_variable fCV {};
+    Stats fStats {};
+
+public:
+    InputPrefetcher(TTree* user, std::shared_ptr<TFile> file, std::shared_ptr<TTree> tree, int depth,
+                    long long cacheSize);
+    ~InputPrefetcher();
+    InputPrefetcher(const InputPrefetcher&) = delete;
+    InputPrefetcher& operator=(const InputPrefetcher&) = delete;
+
+    // Starts reading ahead from entry
+    void Start(int entry);
+    // Serves entry to the consumer. Returns false if it is not the expected one
+    bool GetEntry(int entry);
+    // Joins the reader thread
+    void Stop();
+
+    //! The reader also updates them: only read them once Stop() has returned
+    const Stats& GetStats() const { return fStats; }
+
+private:
+    void InitBranches(long long cacheSize);
+    void Read();
+};
+} // namespace ActRoot
+
+#endif
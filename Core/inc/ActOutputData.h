@@ -1,6 +1,7 @@
 #ifndef ActOutputData_h
 #define ActOutputData_h
 
+#include "ActAsyncWriter.h"
 #include "ActInputParser.h"
 
 #include "TFile.h"
@@ -23,6 +24,10 @@ private:
     std::map<int, std::shared_ptr<TFile>> fFiles {};
     std::map<int, std::shared_ptr<TTree>> fTrees {};
     std::set<int> fRuns {};
+    // Optional writer stage
+    int fAsyncDepth {}; //!< Size of queue of entries to be filled. 0 fills in the calling thread
+    std::map<int, std::shared_ptr<AsyncWriter>> fWriters {};
+    AsyncWriter::Stats fAsyncStats {}; //!< Accumulated over closed runs
 
 public:
     OutputData() = default;
@@ -39,6 +44,11 @@ public:
     // Write TTree and close TFile
     void Close(int run);
 
+    // Fill and compress in a dedicated thread per run, with a queue of depth entries
+    void SetAsync(int depth);
+    const AsyncWriter::Stats& GetAsyncStats() const { return fAsyncStats; }
+    void PrintAsyncStats() const;
+
     // Function to write analysis parameters next to TTree
     void WriteMetadata(const std::string& file, const std::string& description = "");
 
@@ -46,6 +56,8 @@ public:
     std::map<int, std::shared_ptr<TTree>> GetTrees() const { return fTrees; }
     std::shared_ptr<TTree> GetTree(int run) const { return fTrees.at(run); }
     const std::set<int>& GetRunList() const { return fRuns; }
+    const std::string& GetTreeName() const { return fTreeName; }
+    std::string GetFileName(int run) const;
 
 private:
     void ParseBlock(BlockPtr block);
@@ -0,0 +1,103 @@
+#ifndef ActParallelOutputData_h
+#define ActParallelOutputData_h
+
+#include "ActAsyncWriter.h"
+#include "ActOutputData.h"
+
+#include "RVersion.h"
+#include "TTree.h"
+
+#include "ROOT/TBufferMerger.hxx"
+
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ActRoot
+{
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6, 26, 0)
+using BufferMerger = ROOT::TBufferMerger;
+using BufferMergerFile = ROOT::TBufferMergerFile;
+#else
+using BufferMerger = ROOT::Experimental::TBufferMerger;
+using BufferMergerFile = ROOT::Experimental::TBufferMergerFile;
+#endif
+
+//! Output of a run filled concurrently by several workers into a single file
+/*!
+  Backed by ROOT's TBufferMerger: each worker fills the tree of a chunk of entries
+  in an in-memory file whose compressed baskets are appended to the output file.
+  Chunks are written strictly in increasing index so the output tree keeps the entry
+  ordering of the input. A chunk that finishes before its predecessors is parked in
+  memory, with its whole in-memory file, until its turn comes.
+  To bound that memory, with SetMaxAhead(n) GetChunk blocks while the requested chunk is
+  more than n indexes ahead of the next one to be written, so at most n + 1 chunks of a
+  run are held at once. Chunks must then be started in increasing order by each worker,
+  as ChunkScheduler does, or the worker of the next chunk could be the one waiting
+*/
+class ParallelOutputData
+{
+public:
+    //! Part of the output tree of a run being filled by a single worker
+    class Chunk
+    {
+    public:
+        int fRun {};
+        int fIdx {};
+        int fNFilled {}; //!< Entries filled since last write
+        std::shared_ptr<BufferMergerFile> fFile {};
+        std::shared_ptr<TTree> fTree {};
+        std::shared_ptr<AsyncWriter> fWriter {}; //!< Only if asynchronous writing is enabled
+    };
+
+private:
+    class RunInfo
+    {
+    public:
+        std::mutex fMutex {};
+        std::condition_variable fCV {}; //!< Notified when fNext advances
+        std::shared_ptr<BufferMerger> fMerger {};
+        int fNChunks {};
+        int fNext {}; //!< Index of the next chunk to be written
+        std::map<int, std::shared_ptr<Chunk>> fParked {};
+        AsyncWriter::Stats fAsyncStats {};
+    };
+
+    OutputData fOutput {}; //!< Holds names of tree and files
+    std::map<int, std::shared_ptr<RunInfo>> fRuns {};
+    int fFlushEntries {1000}; //!< Chunk at its turn is written each time this number of entries is filled
+    int fAsyncDepth {};       //!< Queue size of the writer thread of each chunk. 0 fills in the worker
+    int fMaxAhead {};         //!< Chunks allowed ahead of the next to be written. <= 0 means no limit
+
+public:
+    ParallelOutputData() = default;
+    ParallelOutputData(const OutputData& out) : fOutput(out) {}
+
+    // Set number of chunks each run is split in
+    void Init(const std::map<int, int>& chunksPerRun, bool print = true);
+
+    // Get chunk to be filled by a worker
+    std::shared_ptr<Chunk> GetChunk(int run, int idx);
+
+    // Fill entry
+    void Fill(const std::shared_ptr<Chunk>& chunk);
+
+    // Chunk has been completely filled: write it once all the previous ones are written
+    void Commit(const std::shared_ptr<Chunk>& chunk);
+
+    void SetFlushEntries(int n) { fFlushEntries = n; }
+    void SetMaxAhead(int n) { fMaxAhead = n; }
+    // Fill and compress each chunk in a dedicated thread, with a queue of depth entries
+    void SetAsync(int depth);
+    AsyncWriter::Stats GetAsyncStats() const;
+
+private:
+    void FillChunk(Chunk& chunk);
+    void Write(Chunk& chunk, bool release);
+    void WriteParked(RunInfo& info);
+};
+} // namespace ActRoot
+
+#endif
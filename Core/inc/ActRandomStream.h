@@ -0,0 +1,43 @@
+#ifndef ActRandomStream_h
+#define ActRandomStream_h
+
+#include "TRandom.h"
+
+namespace ActRoot
+{
+//! Counter-based random generator, reproducible per event
+/*!
+  Numbers are a hash of a key and a counter, with no other internal state. The key is built
+  from (seed, stream, run, entry) in SetEvent, so the sequence of each event does not depend
+  on which thread processes it nor on the events processed before.
+  Each thread must own its instances: they are not shared
+*/
+class RandomStream : public TRandom
+{
+private:
+    unsigned long long fSeed {};    //!< Global seed
+    unsigned long long fStream {};  //!< Identifier of the component using it
+    unsigned long long fKey {};     //!< Hash of seed, stream, run and entry
+    unsigned long long fCounter {}; //!< Numbers drawn since last SetEvent
+
+public:
+    RandomStream(unsigned long long seed = 0, unsigned long long stream = 0);
+    ~RandomStream() override = default;
+
+    // Restart sequence for a given event
+    void SetEvent(int run, int entry);
+    void SetStream(unsigned long long stream) { fStream = stream; }
+
+    // TRandom interface: all distributions are built from Rndm
+    Double_t Rndm() override;
+    void RndmArray(Int_t n, Float_t* array) override;
+    void RndmArray(Int_t n, Double_t* array) override;
+    void SetSeed(ULong_t seed = 0) override;
+    UInt_t GetSeed() const override { return static_cast<UInt_t>(fSeed); }
+
+private:
+    static unsigned long long Mix(unsigned long long x);
+};
+} // namespace ActRoot
+
+#endif
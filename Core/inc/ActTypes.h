@@ -15,12 +15,14 @@ enum class ModeType
 {
     EReadTPC,     // !< Convert from Raw to TPCData
     EReadSilMod,  // !< Convert from Raw to Sil and Modular data
+    EReadAll,     // !< Both conversions from Raw in a single pass
     EFilter,      // !< Exec filter before Merger
     EMerge,       // !< Merge detectors and build physical event
     EFilterMerge, // !< Both operations at the same time
     ECorrect,     // !< Exec filter after merger
     EGui,         // !< For GUI in actplot
     ESimu,        // !< Simulation mode
+    ESimuReco,    // !< Simulation reconstructed in memory up to Merger
     ENone         // !< Default value
 };
 
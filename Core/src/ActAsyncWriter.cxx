@@ -0,0 +1,173 @@
+#include "ActAsyncWriter.h"
+
+#include "ActColors.h"
+
+#include "TBranch.h"
+#include "TBranchElement.h"
+#include "TClass.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+void ActRoot::AsyncWriter::Stats::Add(const Stats& other)
+{
+    fNFilled += other.fNFilled;
+    fStalls += other.fStalls;
+    fFillTime += other.fFillTime;
+    fBusyTime += other.fBusyTime;
+    fDepth = std::max(fDepth, other.fDepth);
+}
+
+void ActRoot::AsyncWriter::Stats::Print() const
+{
+    std::cout << BOLDYELLOW << "---- AsyncWriter stats ----" << '\n';
+    std::cout << "-> Queue capacity      : " << fDepth << '\n';
+    std::cout << "-> Filled entries      : " << fNFilled << '\n';
+    std::cout << "-> Reconstruction time : " << std::setprecision(4) << fBusyTime << " s" << '\n';
+    std::cout << "-> Fill + compression  : " << std::setprecision(4) << fFillTime << " s" << '\n';
+    std::cout << "-> Reco / compression  : " << std::setprecision(3) << GetRatio() << '\n';
+    std::cout << "-> Stalls (queue full) : " << fStalls << '\n';
+    std::cout << "--------------------" << RESET << '\n';
+}
+
+ActRoot::AsyncWriter::AsyncWriter(TTree* tree, int depth, std::function<void()> fill)
+    : fTree(tree),
+      fFill(fill),
+      fSlots(depth)
+{
+    if(depth < 1)
+        throw std::invalid_argument("AsyncWriter: depth of queue must be >= 1");
+    if(!fFill)
+        fFill = [this] { fTree->Fill(); };
+    fStats.fDepth = depth;
+    InitBranches();
+    for(int i = 0; i < fSlots.size(); i++)
+        fFree.push_back(i);
+    fStart = std::chrono::steady_clock::now();
+    fThread = std::thread(&ActRoot::AsyncWriter::Write, this);
+}
+
+ActRoot::AsyncWriter::~AsyncWriter()
+{
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock {fMutex};
+        fStop = true;
+    }
+    fCV.notify_all();
+    if(fThread.joinable())
+        fThread.join();
+    // Give the tree back its original addresses
+    for(int b = 0; b < fBranchNames.size(); b++)
+        fTree->SetBranchAddress(fBranchNames[b].c_str(), static_cast<void*>(fUserAddresses[b]));
+    // Objects held by the detectors are deleted by them
+    for(auto& slot : fSlots)
+        for(int b = 0; b < fClasses.size(); b++)
+            fClasses[b]->Destructor(slot.fObjects[b]);
+}
+
+void ActRoot::AsyncWriter::InitBranches()
+{
+    for(auto* obj : *fTree->GetListOfBranches())
+    {
+        auto* branch {static_cast<TBranch*>(obj)};
+        auto* element {dynamic_cast<TBranchElement*>(branch)};
+        if(!element)
+            throw std::runtime_error("AsyncWriter: branch " + std::string(branch->GetName()) +
+                                     " is not an object branch, cannot write it asynchronously");
+        if(!element->GetAddress())
+            continue;
+        fBranchNames.push_back(branch->GetName());
+        // Top-level branches store the address of the pointer set by the detectors
+        fUserAddresses.push_back(reinterpret_cast<void**>(element->GetAddress()));
+        fClasses.push_back(TClass::GetClass(element->GetClassName()));
+    }
+    for(auto& slot : fSlots)
+        for(auto* cl : fClasses)
+            slot.fObjects.push_back(cl->New());
+    // Redirect tree to internal addresses, set by writer thread before each fill
+    fStaging.resize(fBranchNames.size());
+    for(int b = 0; b < fBranchNames.size(); b++)
+    {
+        fStaging[b] = fSlots.front().fObjects[b];
+        // Untyped overload: the class is already known by the branch
+        fTree->SetBranchAddress(fBranchNames[b].c_str(), static_cast<void*>(&fStaging[b]));
+    }
+}
+
+void ActRoot::AsyncWriter::Push()
+{
+    int idx {};
+    {
+        std::unique_lock<std::mutex> lock {fMutex};
+        if(fFree.empty())
+        {
+            fStats.fStalls++;
+            auto start {std::chrono::steady_clock::now()};
+            fCV.wait(lock, [this] { return !fFree.empty(); });
+            fStallTime += std::chrono::steady_clock::now() - start;
+        }
+        idx = fFree.front();
+        fFree.pop_front();
+    }
+    // Detectors keep on working with a free object while this one is written
+    auto& slot {fSlots[idx]};
+    for(int b = 0; b < fUserAddresses.size(); b++)
+        std::swap(*fUserAddresses[b], slot.fObjects[b]);
+    {
+        std::lock_guard<std::mutex> lock {fMutex};
+        fReady.push_back(idx);
+    }
+    fCV.notify_all();
+}
+
+void ActRoot::AsyncWriter::Flush()
+{
+    auto start {std::chrono::steady_clock::now()};
+    std::unique_lock<std::mutex> lock {fMutex};
+    // Producer time not spent waiting for the writer
+    std::chrono::duration<double> busy {start - fStart - fStallTime};
+    fStats.fBusyTime = busy.count();
+    fCV.wait(lock, [this] { return fReady.empty() && fNInFlight == 0; });
+    fStallTime += std::chrono::steady_clock::now() - start;
+}
+
+void ActRoot::AsyncWriter::Write()
+{
+    while(true)
+    {
+        int idx {};
+        {
+            std::unique_lock<std::mutex> lock {fMutex};
+            fCV.wait(lock, [this] { return fStop || !fReady.empty(); });
+            if(fReady.empty())
+                return;
+            idx = fReady.front();
+            fReady.pop_front();
+            fNInFlight++;
+        }
+        auto& slot {fSlots[idx]};
+        for(int b = 0; b < fStaging.size(); b++)
+            fStaging[b] = slot.fObjects[b];
+        auto start {std::chrono::steady_clock::now()};
+        fFill();
+        std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - start};
+        {
+            std::lock_guard<std::mutex> lock {fMutex};
+            fStats.fFillTime += elapsed.count();
+            fStats.fNFilled++;
+            fFree.push_back(idx);
+            fNInFlight--;
+        }
+        fCV.notify_all();
+    }
+}
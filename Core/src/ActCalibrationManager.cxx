@@ -4,7 +4,6 @@
 
 #include <algorithm>
 #include <cctype>
-#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -42,6 +41,47 @@ void ActRoot::CalibrationManager::ReadCalibration(const std::string& file)
             col++;
         }
     }
+    // Handles already given away must see the new coefficients
+    Compile();
+}
+
+int ActRoot::CalibrationManager::GetHandle(const std::string& key)
+{
+    if(auto it {fHandles.find(key)}; it != fHandles.end())
+        return it->second;
+    int handle {static_cast<int>(fHandleKeys.size())};
+    fHandles[key] = handle;
+    fHandleKeys.push_back(key);
+    fTables.push_back({0, 0});
+    if(auto it {fCalibs.find(key)}; it != fCalibs.end())
+    {
+        fTables.back() = {static_cast<int>(fCoeffs.size()), static_cast<int>(it->second.size())};
+        fCoeffs.insert(fCoeffs.end(), it->second.begin(), it->second.end());
+    }
+    return handle;
+}
+
+void ActRoot::CalibrationManager::Compile()
+{
+    fCoeffs.clear();
+    for(int h = 0; h < fHandleKeys.size(); h++)
+    {
+        fTables[h] = {0, 0};
+        if(auto it {fCalibs.find(fHandleKeys[h])}; it != fCalibs.end())
+        {
+            fTables[h] = {static_cast<int>(fCoeffs.size()), static_cast<int>(it->second.size())};
+            fCoeffs.insert(fCoeffs.end(), it->second.begin(), it->second.end());
+        }
+    }
+}
+
+double ActRoot::CalibrationManager::EvalPolynomial(const double* coeffs, int size, double x) const
+{
+    // Horner's rule: coeffs[0] + x * (coeffs[1] + x * (...))
+    double ret {};
+    for(int i = size - 1; i >= 0; i--)
+        ret = ret * x + coeffs[i];
+    return ret;
 }
 
 void ActRoot::CalibrationManager::ReadPadAlign(const std::string& file)
@@ -119,20 +159,10 @@ void ActRoot::CalibrationManager::ReadInvertedLookUpTable(const std::string& fil
         fInvertedLT[{col4, col5}] = {col0, col1, col2, col3};
     }
 }
-double ActRoot::CalibrationManager::ApplyCalibration(const std::string& key, double raw)
+double ActRoot::CalibrationManager::ApplyCalibration(const std::string& key, double raw) const
 {
-    if(fCalibs.find(key) != fCalibs.end())
-    {
-        double cal {0};
-        int order {0};
-        auto coeffs {fCalibs[key]};
-        for(const auto& coef : coeffs)
-        {
-            cal += coef * std::pow(raw, order);
-            order++;
-        }
-        return cal;
-    }
+    if(auto it {fCalibs.find(key)}; it != fCalibs.end())
+        return EvalPolynomial(it->second.data(), it->second.size(), raw);
     else
     {
         if(!fIsEnabled)
@@ -142,11 +172,11 @@ double ActRoot::CalibrationManager::ApplyCalibration(const std::string& key, dou
     }
 }
 
-bool ActRoot::CalibrationManager::ApplyThreshold(const std::string& key, double raw, double nsigma)
+bool ActRoot::CalibrationManager::ApplyThreshold(const std::string& key, double raw, double nsigma) const
 {
-    if(fCalibs.find(key) != fCalibs.end())
+    if(auto it {fCalibs.find(key)}; it != fCalibs.end())
     {
-        auto coeffs {fCalibs[key]};
+        const auto& coeffs {it->second};
         // Value to compare to
         double threshold {coeffs[0]};
         if(coeffs.size() == 2) // CATS style
@@ -167,30 +197,57 @@ bool ActRoot::CalibrationManager::ApplyThreshold(const std::string& key, double
     }
 }
 
-int ActRoot::CalibrationManager::ApplyLookUp(int channel, int col)
+double ActRoot::CalibrationManager::ApplyCalibration(int handle, double raw) const
+{
+    auto [begin, size] {fTables[handle]};
+    if(size > 0)
+        return EvalPolynomial(&fCoeffs[begin], size, raw);
+    if(!fIsEnabled)
+        return raw;
+    throw std::runtime_error(
+        "CalibrationManager::ApplyCalibration(): fIsEnabled == true but could not find calibration for key " +
+        fHandleKeys[handle]);
+}
+
+bool ActRoot::CalibrationManager::ApplyThreshold(int handle, double raw, double nsigma) const
+{
+    auto [begin, size] {fTables[handle]};
+    if(size > 0)
+    {
+        // Value to compare to
+        double threshold {fCoeffs[begin]};
+        if(size == 2) // CATS style
+            threshold += fCoeffs[begin + 1] * nsigma;
+        return raw >= threshold;
+    }
+    if(!fIsEnabled)
+        return raw;
+    throw std::runtime_error(
+        "CalibrationManager::ApplyThreshold(): fIsEnabled == true but could not find threshold for key " +
+        fHandleKeys[handle]);
+}
+
+int ActRoot::CalibrationManager::ApplyLookUp(int channel, int col) const
 {
     return fLT[channel][col];
 }
 
-std::tuple<int, int, int, int> ActRoot::CalibrationManager::ApplyInvLookUp(int x, int y)
+std::tuple<int, int, int, int> ActRoot::CalibrationManager::ApplyInvLookUp(int x, int y) const
 {
-    return fInvertedLT[{x, y}];
+    // Do not insert missing pads: default values are returned instead
+    if(auto it {fInvertedLT.find({x, y})}; it != fInvertedLT.end())
+        return it->second;
+    return {};
 }
 
-double ActRoot::CalibrationManager::ApplyPadAlignment(int channel, double q)
+double ActRoot::CalibrationManager::ApplyPadAlignment(int channel, double q) const
 {
     // If alignment is disabled, return given value
     if(fPadAlign.size() == 0)
         return q;
     // Else, compute correction with any order given in the file
-    double qAl {};
-    int order {0};
-    for(const auto& coef : fPadAlign[channel])
-    {
-        qAl += coef * std::pow(q, order);
-        order++;
-    }
-    return qAl;
+    const auto& coeffs {fPadAlign[channel]};
+    return EvalPolynomial(coeffs.data(), coeffs.size(), q);
 }
 
 void ActRoot::CalibrationManager::Print() const
@@ -3,14 +3,17 @@
 #include "ActInputData.h"
 #include "ActInputParser.h"
 #include "ActOutputData.h"
+#include "ActParallelOutputData.h"
 #include "ActTypes.h"
 
 #include "TChain.h"
 
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <utility>
+#include <vector>
 
 ActRoot::DataManager::DataManager(const std::string& file, ModeType mode) : fMode(mode)
 {
@@ -36,6 +39,8 @@ void ActRoot::DataManager::ParseManagerBlock(ActRoot::BlockPtr block)
     // 1-> Run list
     // 2-> Exclude list of runs, to skip certains runs in ... expansion
     // 3-> Manual entries file to InputData
+    // 4-> Prefetching and cache size of InputData
+    // 5-> Asynchronous writing of OutputData
     //
     // 1
     auto runs {block->GetIntVector("Runs")};
@@ -52,6 +57,14 @@ void ActRoot::DataManager::ParseManagerBlock(ActRoot::BlockPtr block)
     // 3
     if(block->CheckTokenExists("Manual", true))
         fManual = block->GetString("Manual");
+    // 4
+    if(block->CheckTokenExists("Prefetch", true))
+        fPrefetch = block->GetInt("Prefetch");
+    if(block->CheckTokenExists("CacheSize", true))
+        fCacheSize = block->GetDouble("CacheSize");
+    // 5
+    if(block->CheckTokenExists("AsyncWrite", true))
+        fAsyncWrite = block->GetInt("AsyncWrite");
 }
 
 void ActRoot::DataManager::SetRuns(int low, int up)
@@ -83,6 +96,8 @@ void ActRoot::DataManager::SetInputData(InputData& in, ModeType mode)
         in.AddInput(CheckAndGet("Raw"));
     else if(mode == ModeType::EReadSilMod)
         in.AddInput(CheckAndGet("Raw"));
+    else if(mode == ModeType::EReadAll)
+        in.AddInput(CheckAndGet("Raw"));
     else if(mode == ModeType::EFilter)
         in.AddInput(CheckAndGet("Cluster"));
     else if(mode == ModeType::EMerge)
@@ -120,14 +135,29 @@ void ActRoot::DataManager::SetOutputData(OutputData& out, ModeType mode)
         ;
     else if(mode == ModeType::ECorrect)
         out.AddOuput(CheckAndGet("Corrector"));
+    else if(mode == ModeType::ESimu || mode == ModeType::ESimuReco)
+        out.AddOuput(CheckAndGet("Simu"));
+    else if(mode == ModeType::EReadAll)
+        throw std::invalid_argument("DataManager::GetOutput(): ReadAll has one output per mode in GetOutputModes()");
     else
         throw std::invalid_argument("DataManager::GetOutput(): mode not implemented yet");
 }
 
+std::vector<ActRoot::ModeType> ActRoot::DataManager::GetOutputModes() const
+{
+    // Single-pass raw decoding writes both Cluster and Data tiers
+    if(fMode == ModeType::EReadAll)
+        return {ModeType::EReadTPC, ModeType::EReadSilMod};
+    return {fMode};
+}
+
 ActRoot::InputData ActRoot::DataManager::GetInput(ActRoot::ModeType mode)
 {
     InputData in;
     SetInputData(in, mode);
+    // GUI accesses entries randomly and shares pointers with InputWrapper: no prefetching
+    if(mode != ModeType::EGui)
+        in.SetPrefetch(fPrefetch, fCacheSize);
     in.Init(fRuns);
     in.AddManualEntries(fManual);
     return std::move(in);
@@ -137,6 +167,7 @@ ActRoot::InputData ActRoot::DataManager::GetInputForThread(const std::set<int>&
 {
     InputData in;
     SetInputData(in, fMode);
+    in.SetPrefetch(fPrefetch, fCacheSize);
     in.Init(runs, false);
     return std::move(in);
 }
@@ -145,14 +176,27 @@ ActRoot::OutputData ActRoot::DataManager::GetOutputForThread(const std::set<int>
 {
     OutputData out;
     SetOutputData(out, fMode);
+    out.SetAsync(fAsyncWrite);
     out.Init(runs, false);
     return std::move(out);
 }
 
+ActRoot::ParallelOutputData ActRoot::DataManager::GetParallelOutput(const std::map<int, int>& chunksPerRun,
+                                                                    ModeType mode)
+{
+    OutputData out;
+    SetOutputData(out, mode);
+    ParallelOutputData par {out};
+    par.SetAsync(fAsyncWrite);
+    par.Init(chunksPerRun);
+    return par;
+}
+
 ActRoot::OutputData ActRoot::DataManager::GetOuput(ActRoot::ModeType mode)
 {
     OutputData out;
     SetOutputData(out, mode);
+    out.SetAsync(fAsyncWrite);
     out.Init(fRuns);
     return std::move(out);
 }
@@ -2,9 +2,11 @@
 
 #include "ActColors.h"
 #include "ActInputParser.h"
+#include "ActInputPrefetcher.h"
 
 #include "TChain.h"
 #include "TFile.h"
+#include "TROOT.h"
 #include "TString.h"
 #include "TTree.h"
 
@@ -66,7 +68,7 @@ void ActRoot::InputData::Init(const std::set<int>& runs, bool print)
     {
         for(const auto& run : runs)
         {
-            std::string filename {fPaths[in] + fBegins[in] + TString::Format("%04d", run) + fEnds[in] + ".root"};
+            auto filename {GetFileName(in, run)};
             CheckFileExists(filename);
             // Print!
             if(print)
@@ -80,6 +82,8 @@ void ActRoot::InputData::Init(const std::set<int>& runs, bool print)
                 fFiles[run] = std::make_shared<TFile>(filename.c_str()); // READ mode by default
                 fTrees[run] = std::shared_ptr<TTree>(fFiles[run]->Get<TTree>(fTreeNames[in].c_str()));
                 CheckTreeExists(fTrees[run], in);
+                if(fCacheSize > 0)
+                    fTrees[run]->SetCacheSize(fCacheSize);
             }
             else // add as friend!
                 fTrees[run]->AddFriend(fTreeNames[in].c_str(), filename.c_str());
@@ -98,7 +102,7 @@ void ActRoot::InputData::InitChain(const std::set<int>& runs)
         fChain = std::make_shared<TChain>(fTreeNames[in].c_str());
         for(const auto& run : runs)
         {
-            std::string filename {fPaths[in] + fBegins[in] + TString::Format("%04d", run) + fEnds[in] + ".root"};
+            auto filename {GetFileName(in, run)};
             CheckFileExists(filename);
             // Print! (disabled for chain)
             // std::cout << BOLDYELLOW << "InputData: reading " << fTreeNames[in] << " to chain in file " << '\n';
@@ -114,11 +118,52 @@ void ActRoot::InputData::InitChain(const std::set<int>& runs)
     }
 }
 
+std::string ActRoot::InputData::GetFileName(int in, int run) const
+{
+    return fPaths[in] + fBegins[in] + TString::Format("%04d", run) + fEnds[in] + ".root";
+}
+
+void ActRoot::InputData::SetPrefetch(int depth, double cacheSize)
+{
+    fPrefetchDepth = depth;
+    fCacheSize = cacheSize * 1024 * 1024;
+    // Reader threads are used even in ST mode
+    if(fPrefetchDepth > 0)
+        ROOT::EnableThreadSafety();
+}
+
+std::shared_ptr<ActRoot::InputPrefetcher> ActRoot::InputData::InitPrefetcher(int run)
+{
+    // Reader thread needs its own copy of files and trees
+    auto file {std::make_shared<TFile>(GetFileName(0, run).c_str())};
+    auto tree {std::shared_ptr<TTree>(file->Get<TTree>(fTreeNames[0].c_str()))};
+    CheckTreeExists(tree, 0);
+    for(int in = 1; in < fTreeNames.size(); in++)
+        tree->AddFriend(fTreeNames[in].c_str(), GetFileName(in, run).c_str());
+    // Branch addresses and statuses are taken from fTrees, so this must be called
+    // after detectors have initialized their inputs
+    return std::make_shared<InputPrefetcher>(fTrees[run].get(), file, tree, fPrefetchDepth, fCacheSize);
+}
+
 void ActRoot::InputData::GetEntry(int run, int entry)
 {
+    if(fPrefetchDepth > 0)
+    {
+        auto& prefetcher {fPrefetchers[run]};
+        if(!prefetcher)
+            prefetcher = InitPrefetcher(run);
+        if(prefetcher->GetEntry(entry))
+            return;
+    }
     fTrees[run]->GetEntry(entry);
 }
 
+void ActRoot::InputData::PrintPrefetchStats() const
+{
+    if(fPrefetchDepth > 0)
+        fPrefetchStats.Print();
+}
+
 void ActRoot::InputData::AddManualEntries(const std::string& file)
 {
     if(file.length() == 0)
@@ -147,6 +192,14 @@ void ActRoot::InputData::AddManualEntries(const std::string& file)
 
 void ActRoot::InputData::Close(int run)
 {
+    // Stop reader thread before closing main files
+    if(auto it {fPrefetchers.find(run)}; it != fPrefetchers.end())
+    {
+        // Join first: the reader thread writes stats until it ends
+        it->second->Stop();
+        fPrefetchStats.Add(it->second->GetStats());
+        fPrefetchers.erase(it);
+    }
     // Reset with use_count = 1 calls destructor, which for TFile calls Close()
     fTrees[run].reset();
     fFiles[run].reset();
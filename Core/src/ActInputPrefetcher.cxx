@@ -0,0 +1,235 @@
+#include "ActInputPrefetcher.h"
+
+#include "ActColors.h"
+
+#include "TBranch.h"
+#include "TBranchElement.h"
+#include "TClass.h"
+#include "TFile.h"
+#include "TFriendElement.h"
+#include "TList.h"
+#include "TObjArray.h"
+#include "TTree.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+void ActRoot::InputPrefetcher::Stats::Add(const Stats& other)
+{
+    fNServed += other.fNServed;
+    fNRestarts += other.fNRestarts;
+    fConsumerStalls += other.fConsumerStalls;
+    fProducerStalls += other.fProducerStalls;
+    fDepthSum += other.fDepthSum;
+    fDepth = std::max(fDepth, other.fDepth);
+}
+
+void ActRoot::InputPrefetcher::Stats::Print() const
+{
+    std::cout << BOLDYELLOW << "---- InputPrefetcher stats ----" << '\n';
+    std::cout << "-> Queue capacity    : " << fDepth << '\n';
+    std::cout << "-> Average depth     : " << std::setprecision(3) << GetAverageDepth() << '\n';
+    std::cout << "-> Served entries    : " << fNServed << '\n';
+    std::cout << "-> Restarts          : " << fNRestarts << '\n';
+    std::cout << "-> Consumer stalls   : " << fConsumerStalls << " (queue empty -> I/O-bound)" << '\n';
+    std::cout << "-> Producer stalls   : " << fProducerStalls << " (queue full -> CPU-bound)" << '\n';
+    std::cout << "--------------------" << RESET << '\n';
+}
+
+namespace
+{
+// Copies activation status of src branch hierarchy into dst, which has the same structure
+void CopyStatus(TBranch* src, TBranch* dst)
+{
+    dst->SetBit(kDoNotProcess, src->TestBit(kDoNotProcess));
+    auto* srcList {src->GetListOfBranches()};
+    auto* dstList {dst->GetListOfBranches()};
+    for(int i = 0, size = srcList->GetEntriesFast(); i < size && i < dstList->GetEntriesFast(); i++)
+        CopyStatus(static_cast<TBranch*>(srcList->At(i)), static_cast<TBranch*>(dstList->At(i)));
+}
+} // namespace
+
+ActRoot::InputPrefetcher::InputPrefetcher(TTree* user, std::shared_ptr<TFile> file, std::shared_ptr<TTree> tree,
+                                          int depth, long long cacheSize)
+    : fUser(user),
+      fFile(file),
+      fTree(tree),
+      fSlots(depth)
+{
+    if(depth < 1)
+        throw std::invalid_argument("InputPrefetcher: depth of queue must be >= 1");
+    fEnd = fTree->GetEntries();
+    fStats.fDepth = depth;
+    InitBranches(cacheSize);
+}
+
+ActRoot::InputPrefetcher::~InputPrefetcher()
+{
+    Stop();
+    // Objects in queue are owned by this class: those held by the consumer are deleted by it
+    for(auto& slot : fSlots)
+        for(int b = 0; b < fClasses.size(); b++)
+            fClasses[b]->Destructor(slot.fObjects[b]);
+    // Tree before file
+    fTree.reset();
+    fFile.reset();
+}
+
+void ActRoot::InputPrefetcher::InitBranches(long long cacheSize)
+{
+    // Collect branches of main tree and its friends used by the consumer
+    std::vector<TTree*> trees {fUser};
+    if(auto* friends {fUser->GetListOfFriends()}; friends)
+        for(auto* obj : *friends)
+            trees.push_back(static_cast<TFriendElement*>(obj)->GetTree());
+    // Disable all and enable only those in use
+    fTree->SetBranchStatus("*", false);
+    for(auto* tree : trees)
+    {
+        for(auto* obj : *tree->GetListOfBranches())
+        {
+            auto* branch {static_cast<TBranch*>(obj)};
+            if(branch->TestBit(kDoNotProcess) || !branch->GetAddress())
+                continue;
+            auto* element {dynamic_cast<TBranchElement*>(branch)};
+            if(!element)
+                throw std::runtime_error("InputPrefetcher: branch " + std::string(branch->GetName()) +
+                                         " is not an object branch, cannot prefetch it");
+            auto* copy {fTree->GetBranch(branch->GetName())};
+            if(!copy)
+                throw std::runtime_error("InputPrefetcher: could not locate branch " + std::string(branch->GetName()));
+            CopyStatus(branch, copy);
+            fBranchNames.push_back(branch->GetName());
+            // Top-level branches store the address of the pointer set by the detectors
+            fUserAddresses.push_back(reinterpret_cast<void**>(element->GetAddress()));
+            fClasses.push_back(TClass::GetClass(element->GetClassName()));
+        }
+    }
+    // Allocate objects of queue
+    for(auto& slot : fSlots)
+        for(auto* cl : fClasses)
+            slot.fObjects.push_back(cl->New());
+    // Register staging addresses, which are updated before each read
+    fStaging.resize(fBranchNames.size());
+    for(int b = 0; b < fBranchNames.size(); b++)
+    {
+        fStaging[b] = fSlots.front().fObjects[b];
+        // Untyped overload: the class is already known by the branch
+        fTree->SetBranchAddress(fBranchNames[b].c_str(), static_cast<void*>(&fStaging[b]));
+    }
+    // Cache restricted to used branches; each friend has its own cache
+    std::vector<TTree*> copies {fTree.get()};
+    if(auto* friends {fTree->GetListOfFriends()}; friends)
+        for(auto* obj : *friends)
+            copies.push_back(static_cast<TFriendElement*>(obj)->GetTree());
+    for(auto* tree : copies)
+    {
+        if(cacheSize > 0)
+            tree->SetCacheSize(cacheSize);
+        for(const auto& name : fBranchNames)
+            if(tree->GetListOfBranches()->FindObject(name.c_str()))
+                tree->AddBranchToCache(name.c_str(), true);
+        tree->StopCacheLearningPhase();
+    }
+}
+
+void ActRoot::InputPrefetcher::Start(int entry)
+{
+    Stop();
+    // Every slot becomes free again
+    fReady.clear();
+    fFree.clear();
+    for(int i = 0; i < fSlots.size(); i++)
+        fFree.push_back(i);
+    fNext = entry;
+    fExpected = entry;
+    fStop = false;
+    fThread = std::thread(&ActRoot::InputPrefetcher::Read, this);
+}
+
+void ActRoot::InputPrefetcher::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock {fMutex};
+        fStop = true;
+    }
+    fCV.notify_all();
+    if(fThread.joinable())
+        fThread.join();
+}
+
+void ActRoot::InputPrefetcher::Read()
+{
+    while(true)
+    {
+        int idx {};
+        int entry {};
+        {
+            std::unique_lock<std::mutex> lock {fMutex};
+            if(fFree.empty() && !fStop)
+            {
+                fStats.fProducerStalls++;
+                fCV.wait(lock, [this] { return fStop || !fFree.empty(); });
+            }
+            if(fStop || fNext >= fEnd)
+                return;
+            idx = fFree.front();
+            fFree.pop_front();
+            entry = fNext++;
+        }
+        // Read outside of lock
+        auto& slot {fSlots[idx]};
+        for(int b = 0; b < fStaging.size(); b++)
+            fStaging[b] = slot.fObjects[b];
+        fTree->GetEntry(entry);
+        {
+            std::lock_guard<std::mutex> lock {fMutex};
+            fReady.push_back(idx);
+        }
+        fCV.notify_all();
+    }
+}
+
+bool ActRoot::InputPrefetcher::GetEntry(int entry)
+{
+    if(entry < 0 || entry >= fEnd)
+        return false;
+    // Random access: read ahead from this entry on
+    if(entry != fExpected || !fThread.joinable())
+    {
+        if(fThread.joinable())
+            fStats.fNRestarts++;
+        Start(entry);
+    }
+    int idx {};
+    {
+        std::unique_lock<std::mutex> lock {fMutex};
+        fStats.fDepthSum += fReady.size();
+        if(fReady.empty())
+        {
+            fStats.fConsumerStalls++;
+            fCV.wait(lock, [this] { return !fReady.empty(); });
+        }
+        idx = fReady.front();
+        fReady.pop_front();
+    }
+    // Hand objects to consumer and take back the ones it was using
+    auto& slot {fSlots[idx]};
+    for(int b = 0; b < fUserAddresses.size(); b++)
+        std::swap(*fUserAddresses[b], slot.fObjects[b]);
+    {
+        std::lock_guard<std::mutex> lock {fMutex};
+        fFree.push_back(idx);
+    }
+    fCV.notify_all();
+    fStats.fNServed++;
+    fExpected++;
+    return true;
+}
@@ -14,9 +14,18 @@
 #include <string>
 
 std::unordered_map<ActRoot::ModeType, std::string> ActRoot::Options::fModeTable = {
-    {ModeType::ENone, "None"},       {ModeType::EReadTPC, "ReadTPC"}, {ModeType::EReadSilMod, "ReadSilMod"},
-    {ModeType::EFilter, "Filter"},   {ModeType::EMerge, "Merger"},    {ModeType::EFilterMerge, "Filter&Merge"},
-    {ModeType::ECorrect, "Correct"}, {ModeType::EGui, "Visual"},      {ModeType::ESimu, "Simulation"}};
+    {ModeType::ENone, "None"},
+    {ModeType::EReadTPC, "ReadTPC"},
+    {ModeType::EReadSilMod, "ReadSilMod"},
+    {ModeType::EReadAll, "ReadAll"},
+    {ModeType::EFilter, "Filter"},
+    {ModeType::EMerge, "Merger"},
+    {ModeType::EFilterMerge, "Filter&Merge"},
+    {ModeType::ECorrect, "Correct"},
+    {ModeType::EGui, "Visual"},
+    {ModeType::ESimu, "Simulation"},
+    {ModeType::ESimuReco, "Simu&Reco"},
+};
 
 std::shared_ptr<ActRoot::Options> ActRoot::Options::fInstance = nullptr;
 
@@ -63,9 +72,11 @@ ActRoot::ModeType ActRoot::Options::ReadFlagToMode(TString flag)
         return ModeType::EReadTPC;
     else if(flag == "sil" || flag == "mod" || flag == "silmod")
         return ModeType::EReadSilMod;
+    else if(flag == "all")
+        return ModeType::EReadAll;
     else
         throw std::invalid_argument(
-            "Options::ReadFlagToMode(): unrecongnized flag passed in read (-r) mode. Options are TPC and Sil/Mod");
+            "Options::ReadFlagToMode(): unrecongnized flag passed in read (-r) mode. Options are TPC, Sil/Mod and All");
 }
 
 void ActRoot::Options::Parse(int argc, char** argv)
@@ -91,6 +102,12 @@ void ActRoot::Options::Parse(int argc, char** argv)
         // Correct mode
         else if(arg == "-c")
             fMode = ModeType::ECorrect;
+        // Simulation mode
+        else if(arg == "-sim")
+            fMode = ModeType::ESimu;
+        // Simulation reconstructed up to Merger
+        else if(arg == "-simreco")
+            fMode = ModeType::ESimuReco;
         // GUI mode
         else if(arg == "-gui")
             fMode = ModeType::EGui;
@@ -127,10 +144,14 @@ void ActRoot::Options::Help() const
     std::cout << BOLDCYAN << "---- ActRoot::Options help ----" << '\n';
     std::cout << "List of valid arguments is : " << '\n';
     std::cout << "-h : Displays this help" << '\n';
-    std::cout << "-r TPC | Sil·Mod : Reads TPC or Sil and Modular data" << '\n';
+    std::cout << "-r TPC | Sil·Mod | All : Reads TPC or Sil and Modular data, or all of them in a single pass" << '\n';
     std::cout << "-f : Performs filter operation at first stage" << '\n';
     std::cout << "-m : Runs merger detector" << '\n';
     std::cout << "-c : Performs filter operation at second stage: corrects MergerData" << '\n';
+    std::cout << "-sim : Runs the simulation described in simulation.conf (only valid for actroot)" << '\n';
+    std::cout << "-simreco : As -sim, but reconstructs events up to Merger with -det and -cal files (only valid for "
+                 "actroot)"
+              << '\n';
     std::cout << "-gui : Set visual mode (only valid for actplot)" << '\n';
     std::cout << "-det file.detector : Sets detector config file" << '\n';
     std::cout << "-cal file.calibrations : Sets calibrations for detectors" << '\n';
@@ -138,7 +159,7 @@ void ActRoot::Options::Help() const
     std::cout << "-runs output.runs : Sets data flow configuration" << '\n';
     std::cout << "-mt or -st : Enables MT or ST mode" << '\n';
     std::cout << "-v : Enables verbose mode for algorithms" << '\n';
-    std::cout << "--with-trigger in combination with -r tpc appends triggerID to TPCData" << '\n';
+    std::cout << "--with-trigger in combination with -r tpc or -r all appends triggerID to TPCData" << '\n';
     std::cout << "--------------------" << RESET << '\n';
 }
 
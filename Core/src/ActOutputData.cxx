@@ -1,11 +1,13 @@
 #include "ActOutputData.h"
 
+#include "ActAsyncWriter.h"
 #include "ActColors.h"
 #include "ActInputParser.h"
 
 #include "TDirectory.h"
 #include "TFile.h"
 #include "TMacro.h"
+#include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
 
@@ -46,7 +48,7 @@ void ActRoot::OutputData::Init(const std::set<int>& runs, bool print)
 
     for(const auto& run : runs)
     {
-        std::string filename {fPath + fBegin + TString::Format("%04d", run) + fEnd + ".root"};
+        auto filename {GetFileName(run)};
         // Print
         if(print)
         {
@@ -63,13 +65,48 @@ void ActRoot::OutputData::Init(const std::set<int>& runs, bool print)
     }
 }
 
+std::string ActRoot::OutputData::GetFileName(int run) const
+{
+    return fPath + fBegin + TString::Format("%04d", run) + fEnd + ".root";
+}
+
+void ActRoot::OutputData::SetAsync(int depth)
+{
+    fAsyncDepth = depth;
+    // Writer threads are used even in ST mode
+    if(fAsyncDepth > 0)
+        ROOT::EnableThreadSafety();
+}
+
 void ActRoot::OutputData::Fill(int run)
 {
-    fTrees[run]->Fill();
+    if(fAsyncDepth < 1)
+    {
+        fTrees[run]->Fill();
+        return;
+    }
+    // Writer is created at first fill, once detectors have set their branches
+    auto& writer {fWriters[run]};
+    if(!writer)
+        writer = std::make_shared<AsyncWriter>(fTrees[run].get(), fAsyncDepth);
+    writer->Push();
+}
+
+void ActRoot::OutputData::PrintAsyncStats() const
+{
+    if(fAsyncDepth > 0)
+        fAsyncStats.Print();
 }
 
 void ActRoot::OutputData::Close(int run)
 {
+    // Queued entries must be in the tree before writing
+    if(auto it {fWriters.find(run)}; it != fWriters.end())
+    {
+        it->second->Flush();
+        fAsyncStats.Add(it->second->GetStats());
+        fWriters.erase(it);
+    }
     // Write to file assigned to tree in run
     // option kWriteDelete erases previous cycle metadata
     // keeping only the highest
@@ -0,0 +1,159 @@
+#include "ActParallelOutputData.h"
+
+#include "ActAsyncWriter.h"
+#include "ActColors.h"
+#include "ActOutputData.h"
+
+#include "TDirectory.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <condition_variable>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+void ActRoot::ParallelOutputData::Init(const std::map<int, int>& chunksPerRun, bool print)
+{
+    // Assert OutputData was set before
+    if(fOutput.GetTreeName().length() < 1)
+        throw std::runtime_error("ParallelOutputData::Init(): called without inner parameters set");
+    for(const auto& [run, nchunks] : chunksPerRun)
+    {
+        if(print)
+        {
+            std::cout << BOLDCYAN << "ParallelOutputData: saving " << fOutput.GetTreeName() << " tree in file" << '\n';
+            std::cout << "  " << fOutput.GetFileName(run) << " from " << nchunks << " chunks" << RESET << '\n';
+        }
+        auto info {std::make_shared<RunInfo>()};
+        info->fNChunks = nchunks;
+        fRuns[run] = info;
+    }
+}
+
+std::shared_ptr<ActRoot::ParallelOutputData::Chunk> ActRoot::ParallelOutputData::GetChunk(int run, int idx)
+{
+    auto& info {*fRuns.at(run)};
+    auto chunk {std::make_shared<Chunk>()};
+    chunk->fRun = run;
+    chunk->fIdx = idx;
+    {
+        std::unique_lock<std::mutex> lock {info.fMutex};
+        // Backpressure: wait for the writer to catch up instead of parking more chunks in memory
+        if(fMaxAhead > 0)
+            info.fCV.wait(lock, [&] { return idx - info.fNext <= fMaxAhead; });
+        // Output file is opened only when the first chunk of the run starts
+        // Compression 505 as in OutputData. In-memory files inherit it, so baskets
+        // are compressed by the workers and just copied by the merger
+        if(!info.fMerger)
+            info.fMerger = std::make_shared<BufferMerger>(fOutput.GetFileName(run).c_str(), "recreate", 505);
+        chunk->fFile = info.fMerger->GetFile();
+    }
+    // Tree must be attached to the in-memory file
+    TDirectory::TContext ctx {chunk->fFile.get()};
+    chunk->fTree = std::make_shared<TTree>(fOutput.GetTreeName().c_str(), "An ACTAR TPC tree created with ActRoot");
+    return chunk;
+}
+
+void ActRoot::ParallelOutputData::SetAsync(int depth)
+{
+    fAsyncDepth = depth;
+    if(fAsyncDepth > 0)
+        ROOT::EnableThreadSafety();
+}
+
+ActRoot::AsyncWriter::Stats ActRoot::ParallelOutputData::GetAsyncStats() const
+{
+    AsyncWriter::Stats stats {};
+    for(const auto& [_, info] : fRuns)
+    {
+        std::lock_guard<std::mutex> lock {info->fMutex};
+        stats.Add(info->fAsyncStats);
+    }
+    return stats;
+}
+
+void ActRoot::ParallelOutputData::Fill(const std::shared_ptr<Chunk>& chunk)
+{
+    if(fAsyncDepth < 1)
+    {
+        FillChunk(*chunk);
+        return;
+    }
+    // Writer thread fills the tree and flushes the chunk when at its turn
+    if(!chunk->fWriter)
+        chunk->fWriter = std::make_shared<AsyncWriter>(chunk->fTree.get(), fAsyncDepth,
+                                                       [this, raw = chunk.get()] { FillChunk(*raw); });
+    chunk->fWriter->Push();
+}
+
+void ActRoot::ParallelOutputData::FillChunk(Chunk& chunk)
+{
+    chunk.fTree->Fill();
+    chunk.fNFilled++;
+    if(chunk.fNFilled < fFlushEntries)
+        return;
+    // Chunk at its turn can flush its baskets without waiting for Commit, so its in-memory
+    // file does not grow with its size. Others keep all their entries until their turn
+    auto& info {*fRuns.at(chunk.fRun)};
+    std::lock_guard<std::mutex> lock {info.fMutex};
+    if(chunk.fIdx == info.fNext)
+        Write(chunk, false);
+    else
+        chunk.fNFilled = 0; // check again after another fFlushEntries
+}
+
+void ActRoot::ParallelOutputData::Commit(const std::shared_ptr<Chunk>& chunk)
+{
+    auto& info {*fRuns.at(chunk->fRun)};
+    if(chunk->fWriter)
+    {
+        // Every queued entry must be in the tree, and the detectors' addresses restored, before parking
+        chunk->fWriter->Flush();
+        auto stats {chunk->fWriter->GetStats()};
+        chunk->fWriter.reset();
+        std::lock_guard<std::mutex> lock {info.fMutex};
+        info.fAsyncStats.Add(stats);
+    }
+    std::lock_guard<std::mutex> lock {info.fMutex};
+    if(chunk->fIdx != info.fNext)
+    {
+        // Detach from detector data, which is reused by the worker for its next chunk
+        chunk->fTree->ResetBranchAddresses();
+        info.fParked[chunk->fIdx] = chunk;
+        return;
+    }
+    Write(*chunk, true);
+    info.fNext++;
+    WriteParked(info);
+    info.fCV.notify_all();
+    // Destruction of TBufferMerger writes and closes the output file
+    if(info.fNext == info.fNChunks)
+        info.fMerger.reset();
+}
+
+void ActRoot::ParallelOutputData::Write(Chunk& chunk, bool release)
+{
+    // Sends the content of the in-memory file to the merger queue
+    chunk.fFile->Write();
+    chunk.fNFilled = 0;
+    if(release)
+    {
+        // Tree before the file that owns it
+        chunk.fTree.reset();
+        chunk.fFile.reset();
+    }
+}
+
+void ActRoot::ParallelOutputData::WriteParked(RunInfo& info)
+{
+    for(auto it {info.fParked.find(info.fNext)}; it != info.fParked.end(); it = info.fParked.find(info.fNext))
+    {
+        Write(*it->second, true);
+        info.fParked.erase(it);
+        info.fNext++;
+    }
+}
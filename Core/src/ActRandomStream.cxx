@@ -0,0 +1,54 @@
+#include "ActRandomStream.h"
+
+ActRoot::RandomStream::RandomStream(unsigned long long seed, unsigned long long stream)
+    : fSeed(seed),
+      fStream(stream)
+{
+    SetEvent(0, 0);
+}
+
+unsigned long long ActRoot::RandomStream::Mix(unsigned long long x)
+{
+    // SplitMix64 finalizer: a bijection with good avalanche, so consecutive counters are uncorrelated
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+void ActRoot::RandomStream::SetEvent(int run, int entry)
+{
+    // Chain hashes so that every field changes the whole key
+    auto key {Mix(fSeed)};
+    key = Mix(key ^ fStream);
+    key = Mix(key ^ static_cast<unsigned int>(run));
+    key = Mix(key ^ static_cast<unsigned int>(entry));
+    fKey = key;
+    fCounter = 0;
+}
+
+Double_t ActRoot::RandomStream::Rndm()
+{
+    // 52 random bits mapped to the centers of 2^52 bins, strictly in (0, 1) as TRandom.
+    // With 53 bits, bits + 0.5 is not representable and the largest value rounds to 1
+    auto bits {Mix(fKey + fCounter++) >> 12};
+    return (bits + 0.5) * 0x1.0p-52;
+}
+
+void ActRoot::RandomStream::RndmArray(Int_t n, Float_t* array)
+{
+    for(Int_t i = 0; i < n; i++)
+        array[i] = static_cast<Float_t>(Rndm());
+}
+
+void ActRoot::RandomStream::RndmArray(Int_t n, Double_t* array)
+{
+    for(Int_t i = 0; i < n; i++)
+        array[i] = Rndm();
+}
+
+void ActRoot::RandomStream::SetSeed(ULong_t seed)
+{
+    fSeed = seed;
+    SetEvent(0, 0);
+}
@@ -24,7 +24,10 @@
 // Data and other structures: cluster, line, region,...
 #pragma link C++ class ActRoot::VData + ;
 #pragma link C++ class ActRoot::Voxel + ;
+#pragma link C++ class ActRoot::VoxelCloud;
+#pragma link C++ class ActRoot::Profile1D;
 #pragma link C++ class ActRoot::Region + ;
+#pragma link C++ class ActRoot::LineMoments;
 #pragma link C++ class ActRoot::Line + ;
 #pragma link C++ class ActRoot::Cluster + ;
 #pragma link C++ class ActRoot::TPCData + ;
@@ -32,6 +35,7 @@
 #pragma link C++ class ActRoot::ModularData + ;
 #pragma link C++ class ActRoot::BinaryData + ;
 #pragma link C++ class ActRoot::MergerData + ;
+#pragma link C++ class ActRoot::MergerLeanData + ;
 
 // Schema evolution for ActPhysics::Line to ActRoot::Line
 #pragma read \
@@ -2,6 +2,7 @@
 #define ActLine_h
 
 #include "ActVoxel.h"
+#include "ActVoxelCloud.h"
 
 #include "Rtypes.h"
 
@@ -17,6 +18,68 @@
 
 namespace ActRoot
 {
+//! Charge-weighted first and second moments of a set of points: sufficient statistics of a line fit
+/*!
+  Voxels can be added and removed, and moments of two sets merged, in O(1), and
+  Line::FitMoments() fits them without looping over the voxels again. Unweighted moments of the
+  (non extended) voxel positions are also kept, for the chi2 of fits that fall back to 2D
+*/
+class LineMoments
+{
+    friend class Line;
+
+private:
+    // Weighted
+    double fQ {};
+    double fX {};
+    double fY {};
+    double fZ {};
+    double fXX {};
+    double fYY {};
+    double fZZ {};
+    double fXY {};
+    double fXZ {};
+    double fYZ {};
+    // Unweighted
+    double fN {};
+    double fUX {};
+    double fUY {};
+    double fUZ {};
+    double fUXX {};
+    double fUYY {};
+    double fUZZ {};
+    double fUXY {};
+    double fUXZ {};
+    double fUYZ {};
+
+public:
+    LineMoments() = default;
+    LineMoments(const std::vector<ActRoot::Voxel>& voxels, bool qWeighted = true, bool correctOffset = true,
+                bool useExt = false);
+
+    void Add(const ActRoot::Voxel& voxel, bool qWeighted = true, bool correctOffset = true, bool useExt = false);
+    void Add(const std::vector<ActRoot::Voxel>& voxels, bool qWeighted = true, bool correctOffset = true,
+             bool useExt = false);
+    void Add(const ActRoot::VoxelCloud& cloud, int i, bool qWeighted = true, bool correctOffset = true,
+             bool useExt = false);
+    void Remove(const ActRoot::Voxel& voxel, bool qWeighted = true, bool correctOffset = true, bool useExt = false);
+    void Clear() { *this = {}; }
+
+    LineMoments& operator+=(const LineMoments& other);
+    LineMoments& operator-=(const LineMoments& other);
+    friend LineMoments operator+(LineMoments a, const LineMoments& b) { return a += b; }
+    friend LineMoments operator-(LineMoments a, const LineMoments& b) { return a -= b; }
+
+    double GetWeight() const { return fQ; }
+    int GetN() const { return static_cast<int>(fN); }
+
+private:
+    void AddPoint(float x, float y, float z, double w);
+    void AddPosition(float x, float y, float z, double sign);
+    void AddVoxel(float x, float y, float z, float q, const Voxel::FractionalZ* zs, int nzs, double sign, bool qWeighted,
+                  bool correctOffset, bool useExt);
+};
+
 class Line
 {
 public:
@@ -56,6 +119,9 @@ public:
     XYZPointF MoveToY(float y) const;
     void FitVoxels(const std::vector<ActRoot::Voxel>& voxels, bool qWeighted = true, bool correctOffset = true,
                    bool useExt = false);
+    void FitVoxels(const ActRoot::VoxelCloud& cloud, bool qWeighted = true, bool correctOffset = true,
+                   bool useExt = false);
+    void FitMoments(const ActRoot::LineMoments& moments);
     std::shared_ptr<TPolyLine> GetPolyLine(TString proj, int minX, int maxX, int maxY, int maxZ, int rebinZ) const;
 
     // Display parameters of line
@@ -63,9 +129,13 @@ public:
 
 private:
     void DoFit(const std::vector<ActRoot::Voxel>& points, bool qWeighted, bool correctOffset, bool useExt);
+    void DoFit(const ActRoot::VoxelCloud& cloud, bool qWeighted, bool correctOffset, bool useExt);
+    bool Solve(const ActRoot::LineMoments& moments);
     void Fit2Dfrom3D(double Mi, double Mj, double Sii, double Sjj, double Sij, double w,
                      const std::string& degenerated = "z");
     void Chi2Dfrom3D(const std::vector<ActRoot::Voxel>& voxels, bool correctOffset);
+    void Chi2Dfrom3D(const ActRoot::VoxelCloud& cloud, bool correctOffset);
+    void Chi2Dfrom3D(const ActRoot::LineMoments& moments);
     inline bool IsInRange(double val, double min, double max) const { return (min <= val) && (val <= max); }
     std::shared_ptr<TPolyLine> TreatSaturationLine(TString proj, int maxZ, int rebinZ) const;
 
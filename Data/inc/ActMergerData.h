@@ -69,7 +69,8 @@ public:
     std::vector<float> fSilEs {};           //!< LEGACY
     std::vector<float> fSilNs {};           //!< LEGACY
     // Flag for debugging purpouses
-    std::string fFlag {}; //!< Describes at which point the merger stopped
+    std::string fFlag {};    //!< Describes at which point the merger stopped
+    unsigned char fFlagID {}; //!< Index of fFlag in GetFlagTable(), the only flag stored in lean output
     // Track length
     float fTrackLength {-1}; //!< LEGACY
     // Angles
@@ -99,7 +100,68 @@ public:
     void Print() const override;
     void Stream(std::ostream& streamer) const;
 
-    ClassDefOverride(MergerData, 2);
+    // Flags coded as integers
+    static const std::vector<std::string>& GetFlagTable();
+    static unsigned char GetFlagID(const std::string& flag);
+    void EncodeFlag() { fFlagID = GetFlagID(fFlag); }
+    //! fFlag, or decoded from fFlagID if not stored
+    std::string GetFlag() const;
+
+    ClassDefOverride(MergerData, 3);
+};
+
+//! MergerData without profiles nor flag string, written instead of it with LeanOutput
+/*!
+    Keeps the member names of MergerData, so its split branches are read in the same way.
+    A member added to MergerData must be added here too, and copied in Set and CopyTo
+*/
+class MergerLeanData : public VData
+{
+public:
+    using XYZPointF = ROOT::Math::XYZPointF;
+
+public:
+    // Points
+    XYZPointF fWP {-1, -1, -1};
+    XYZPointF fRP {-1, -1, -1};
+    XYZPointF fSP {-1, -1, -1};
+    XYZPointF fBP {-1, -1, -1};
+    XYZPointF fBSP {-1, -1, -1};
+    XYZPointF fBraggP {-1, -1, -1};
+    // Silicons
+    std::vector<std::string> fSilLayers {};
+    std::vector<float> fSilEs {};
+    std::vector<float> fSilNs {};
+    unsigned char fFlagID {}; //!< Index in MergerData::GetFlagTable()
+    float fTrackLength {-1};
+    // Angles
+    float fThetaBeam {-1};
+    float fThetaBeamZ {-1};
+    float fPhiBeamY {-1};
+    float fThetaLight {-1};
+    float fThetaDebug {-1};
+    float fThetaLegacy {-1};
+    float fThetaHeavy {-1};
+    float fPhiLight {-1};
+    float fPhiHeavy {-1};
+    float fQave {-1};
+    BinaryData fLight {};
+    BinaryData fHeavy {};
+    int fBeamIdx {-1};
+    int fLightIdx {-1};
+    int fHeavyIdx {-1};
+    int fEntry {-1};
+    int fRun {-1};
+
+    void Clear() override;
+    void Print() const override;
+
+    //! Copy every member of data but profiles and flag string
+    void Set(const MergerData& data);
+    //! Inverse of Set. fFlag is decoded from fFlagID and profiles are left empty
+    void CopyTo(MergerData& data) const;
+
+    ClassDefOverride(MergerLeanData, 1);
 };
 } // namespace ActRoot
 
@@ -0,0 +1,66 @@
+#ifndef ActProfile1D_h
+#define ActProfile1D_h
+
+#include "TH1.h"
+
+#include <string>
+#include <vector>
+
+namespace ActRoot
+{
+//! A lightweight 1D histogram to compute charge profiles
+/*!
+  Equally spaced bins as a TH1, but with no ROOT object or gDirectory bookkeeping and
+  with buffers kept between events, so filling and analysing a profile does not allocate
+  once capacity is reached. Smooth reproduces TH1::Smooth(1) (353QH twice) and GetX the root
+  finding of a TF1 built on a TSpline3 "b2,e2" through the bin centers.
+  A TH1F copy is only built on request with FillTH1
+*/
+class Profile1D
+{
+private:
+    std::vector<double> fContent {}; //!< Without under and overflow
+    double fUnderflow {};
+    double fOverflow {};
+    double fEntries {};
+    int fNBins {};
+    double fXMin {};
+    double fXMax {};
+    double fWidth {};
+    // Work buffers
+    std::vector<double> fYY {};
+    std::vector<double> fZZ {};
+    std::vector<double> fRR {};
+    std::vector<double> fM {}; //!< Second derivatives of spline at bin centers
+
+public:
+    Profile1D() = default;
+    Profile1D(int nbins, double xmin, double xmax) { Reset(nbins, xmin, xmax); }
+
+    //! Set binning and clear contents, keeping capacity
+    void Reset(int nbins, double xmin, double xmax);
+    void Fill(double x, double w = 1);
+
+    // Getters, bins in [0, nbins)
+    int GetNBins() const { return fNBins; }
+    double GetEntries() const { return fEntries; }
+    double GetBinContent(int bin) const { return fContent[bin]; }
+    double GetBinCenter(int bin) const { return fXMin + (bin + 0.5) * fWidth; }
+    double GetXMin() const { return fXMin; }
+    double GetXMax() const { return fXMax; }
+    int GetMaximumBin() const;
+
+    void Smooth();
+    //! First x in [xmin, xmax] at which the spline crosses y, scanning npx points as TF1::GetX
+    double GetX(double y, double xmin, double xmax, int npx = 100);
+
+    //! Copy into an existing histogram, setting binning, contents and entries
+    void FillTH1(TH1F& h, const std::string& name, const std::string& title) const;
+
+private:
+    void BuildSpline();
+    double EvalSpline(double x) const;
+};
+} // namespace ActRoot
+
+#endif // !ActProfile1D_h
@@ -28,6 +28,7 @@ public:
     int GetSizeOf(const std::string& key) { return fSizes[key]; }
     void Print() const override; //!< Dump info stored
     std::pair<std::string, int> GetSilIndex(int vxi);
+    const std::map<int, std::pair<std::string, int>>& GetVXIMap() const { return fVXI; }
     void
     ReadActions(const std::vector<std::string>& layers, const std::vector<std::string>& names, const std::string& file);
 };
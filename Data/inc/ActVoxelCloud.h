@@ -0,0 +1,70 @@
+#ifndef ActVoxelCloud_h
+#define ActVoxelCloud_h
+
+#include "ActVoxel.h"
+
+#include "Math/Point3D.h"
+
+#include <vector>
+
+namespace ActRoot
+{
+//! A cloud of voxels stored as structure of arrays
+/*!
+  Positions, charges and flags are kept in contiguous arrays and the fractional Zs of all
+  voxels share a single pool, so copies cost a few allocations regardless of the number of
+  voxels and loops over a coordinate can be vectorized. Capacity is kept between events
+*/
+class VoxelCloud
+{
+public:
+    using XYZPointF = ROOT::Math::XYZPointF;
+    using FractionalZ = Voxel::FractionalZ;
+    enum Flags : unsigned char
+    {
+        kSaturated = 1
+    };
+
+private:
+    std::vector<float> fX {};
+    std::vector<float> fY {};
+    std::vector<float> fZ {};
+    std::vector<float> fQ {};
+    std::vector<unsigned char> fFlags {};
+    std::vector<int> fZsBegin {0};       //!< Offset of each voxel in fZsPool, plus the end of the last
+    std::vector<FractionalZ> fZsPool {}; //!< Fractional Zs of all voxels
+
+public:
+    VoxelCloud() = default;
+    explicit VoxelCloud(const std::vector<Voxel>& voxels) { Assign(voxels); }
+
+    // Filling
+    void Clear();
+    void Reserve(int n);
+    void Add(const Voxel& voxel);
+    void Append(const std::vector<Voxel>& voxels);
+    void Assign(const std::vector<Voxel>& voxels);
+    void Assign(const std::vector<Voxel>& voxels, const std::vector<int>& order);
+
+    // Getters
+    int GetSize() const { return fX.size(); }
+    bool IsEmpty() const { return fX.empty(); }
+    const float* GetX() const { return fX.data(); }
+    const float* GetY() const { return fY.data(); }
+    const float* GetZ() const { return fZ.data(); }
+    const float* GetQ() const { return fQ.data(); }
+    XYZPointF GetPosition(int i) const { return {fX[i], fY[i], fZ[i]}; }
+    float GetCharge(int i) const { return fQ[i]; }
+    bool GetIsSaturated(int i) const { return fFlags[i] & kSaturated; }
+    int GetNZs(int i) const { return fZsBegin[i + 1] - fZsBegin[i]; }
+    const FractionalZ* GetZs(int i) const { return fZsPool.data() + fZsBegin[i]; }
+
+    // Conversion back to AoS
+    Voxel GetVoxel(int i) const;
+    std::vector<Voxel> ToVoxels() const;
+
+    void Print() const;
+};
+} // namespace ActRoot
+
+#endif // !ActVoxelCloud_h
@@ -4,11 +4,13 @@
 #include "ActOptions.h"
 #include "ActUtils.h"
 #include "ActVoxel.h"
+#include "ActVoxelCloud.h"
 
 #include "TMath.h"
 #include "TMathBase.h"
 #include "TPolyLine.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -17,6 +19,140 @@
 #include <string>
 #include <vector>
 
+ActRoot::LineMoments::LineMoments(const std::vector<ActRoot::Voxel>& voxels, bool qWeighted, bool correctOffset,
+                                  bool useExt)
+{
+    Add(voxels, qWeighted, correctOffset, useExt);
+}
+
+void ActRoot::LineMoments::AddPoint(float x, float y, float z, double w)
+{
+    fQ += w;
+    fX += x * w;
+    fY += y * w;
+    fZ += z * w;
+    fXX += x * x * w;
+    fYY += y * y * w;
+    fZZ += z * z * w;
+    fXY += x * y * w;
+    fXZ += x * z * w;
+    fYZ += y * z * w;
+}
+
+void ActRoot::LineMoments::AddPosition(float x, float y, float z, double sign)
+{
+    fN += sign;
+    fUX += x * sign;
+    fUY += y * sign;
+    fUZ += z * sign;
+    fUXX += x * x * sign;
+    fUYY += y * y * sign;
+    fUZZ += z * z * sign;
+    fUXY += x * y * sign;
+    fUXZ += x * z * sign;
+    fUYZ += y * z * sign;
+}
+
+void ActRoot::LineMoments::AddVoxel(float x, float y, float z, float q, const Voxel::FractionalZ* zs, int nzs,
+                                    double sign, bool qWeighted, bool correctOffset, bool useExt)
+{
+    float offset {correctOffset ? 0.5f : 0.f};
+    if(!useExt)
+    {
+        // Offset is not implicitly corrected if useExt is disabled
+        double hitQ {qWeighted ? q : 1.};
+        AddPoint(x + offset, y + offset, z + offset, sign * hitQ);
+    }
+    else
+    {
+        // Same points as Voxel::GetExtended(), offset already corrected, without building them
+        float qz {q / nzs}; // equally distributed charge
+        double hitQ {qWeighted ? qz : 1.};
+        for(int i = 0; i < nzs; i++)
+            AddPoint(x + 0.5f, y + 0.5f, ActRoot::Voxel::RecoverFloat(z, zs[i]), sign * hitQ);
+    }
+    // Chi2 of 2D fits is computed over voxels, not extended
+    AddPosition(x + offset, y + offset, z + offset, sign);
+}
+
+void ActRoot::LineMoments::Add(const ActRoot::Voxel& voxel, bool qWeighted, bool correctOffset, bool useExt)
+{
+    const auto& pos {voxel.GetPosition()};
+    const auto& zs {voxel.GetZs()};
+    AddVoxel(pos.X(), pos.Y(), pos.Z(), voxel.GetCharge(), zs.data(), zs.size(), 1, qWeighted, correctOffset, useExt);
+}
+
+void ActRoot::LineMoments::Add(const std::vector<ActRoot::Voxel>& voxels, bool qWeighted, bool correctOffset,
+                               bool useExt)
+{
+    for(const auto& voxel : voxels)
+        Add(voxel, qWeighted, correctOffset, useExt);
+}
+
+void ActRoot::LineMoments::Add(const ActRoot::VoxelCloud& cloud, int i, bool qWeighted, bool correctOffset,
+                               bool useExt)
+{
+    AddVoxel(cloud.GetX()[i], cloud.GetY()[i], cloud.GetZ()[i], cloud.GetCharge(i), cloud.GetZs(i), cloud.GetNZs(i), 1,
+             qWeighted, correctOffset, useExt);
+}
+
+void ActRoot::LineMoments::Remove(const ActRoot::Voxel& voxel, bool qWeighted, bool correctOffset, bool useExt)
+{
+    const auto& pos {voxel.GetPosition()};
+    const auto& zs {voxel.GetZs()};
+    AddVoxel(pos.X(), pos.Y(), pos.Z(), voxel.GetCharge(), zs.data(), zs.size(), -1, qWeighted, correctOffset, useExt);
+}
+
+ActRoot::LineMoments& ActRoot::LineMoments::operator+=(const LineMoments& other)
+{
+    fQ += other.fQ;
+    fX += other.fX;
+    fY += other.fY;
+    fZ += other.fZ;
+    fXX += other.fXX;
+    fYY += other.fYY;
+    fZZ += other.fZZ;
+    fXY += other.fXY;
+    fXZ += other.fXZ;
+    fYZ += other.fYZ;
+    fN += other.fN;
+    fUX += other.fUX;
+    fUY += other.fUY;
+    fUZ += other.fUZ;
+    fUXX += other.fUXX;
+    fUYY += other.fUYY;
+    fUZZ += other.fUZZ;
+    fUXY += other.fUXY;
+    fUXZ += other.fUXZ;
+    fUYZ += other.fUYZ;
+    return *this;
+}
+
+ActRoot::LineMoments& ActRoot::LineMoments::operator-=(const LineMoments& other)
+{
+    fQ -= other.fQ;
+    fX -= other.fX;
+    fY -= other.fY;
+    fZ -= other.fZ;
+    fXX -= other.fXX;
+    fYY -= other.fYY;
+    fZZ -= other.fZZ;
+    fXY -= other.fXY;
+    fXZ -= other.fXZ;
+    fYZ -= other.fYZ;
+    fN -= other.fN;
+    fUX -= other.fUX;
+    fUY -= other.fUY;
+    fUZ -= other.fUZ;
+    fUXX -= other.fUXX;
+    fUYY -= other.fUYY;
+    fUZZ -= other.fUZZ;
+    fUXY -= other.fUXY;
+    fUXZ -= other.fUXZ;
+    fUYZ -= other.fUYZ;
+    return *this;
+}
+
 ActRoot::Line::Line(XYZPointF point, XYZVectorF direction, float chi) : fPoint(point), fDirection(direction), fChi2(chi)
 {
 }
@@ -88,28 +224,45 @@ void ActRoot::Line::FitVoxels(const std::vector<ActRoot::Voxel>& voxels, bool qW
     DoFit(voxels, qWeighted, correctOffset, useExt);
 }
 
+void ActRoot::Line::FitVoxels(const ActRoot::VoxelCloud& cloud, bool qWeighted, bool correctOffset, bool useExt)
+{
+    DoFit(cloud, qWeighted, correctOffset, useExt);
+}
+
+void ActRoot::Line::FitMoments(const ActRoot::LineMoments& moments)
+{
+    if(Solve(moments))
+        Chi2Dfrom3D(moments);
+}
+
 void ActRoot::Line::DoFit(const std::vector<ActRoot::Voxel>& voxels, bool qWeighted, bool correctOffset, bool useExt)
+{
+    ActRoot::LineMoments moments {voxels, qWeighted, correctOffset, useExt};
+    if(Solve(moments))
+        Chi2Dfrom3D(voxels, correctOffset);
+}
+
+void ActRoot::Line::DoFit(const ActRoot::VoxelCloud& cloud, bool qWeighted, bool correctOffset, bool useExt)
+{
+    ActRoot::LineMoments moments {};
+    for(int i = 0, size = cloud.GetSize(); i < size; i++)
+        moments.Add(cloud, i, qWeighted, correctOffset, useExt);
+    if(Solve(moments))
+        Chi2Dfrom3D(cloud, correctOffset);
+}
+
+bool ActRoot::Line::Solve(const ActRoot::LineMoments& moments)
 {
     //------3D Line Regression
     //----- adapted from: http://fr.scribd.com/doc/31477970/Regressions-et-trajectoires-3D
-    // Paramount importance: use doubles to avoid floating point errors that lead to nans in dim2!!!!
+    // Returns true if the fit fell back to 2D, so chi2 has to be recomputed from the points
     // static_cast back to float when writing XYZThings
     // Default-initialize everything!
-    double Q {};
-    double Xm {};
-    double Ym {};
-    double Zm {};
     double Xh {};
     double Yh {};
     double Zh {};
     double a {};
     double b {};
-    double Sxx {};
-    double Sxy {};
-    double Syy {};
-    double Sxz {};
-    double Szz {};
-    double Syz {};
     double theta {};
     double K11 {};
     double K22 {};
@@ -127,46 +280,17 @@ void ActRoot::Line::DoFit(const std::vector<ActRoot::Voxel>& voxels, bool qWeigh
     double rho {};
     double phi {};
 
-    for(const auto& outer : voxels)
-    {
-        if(!useExt)
-        {
-            const auto& hitQ = (qWeighted ? outer.GetCharge() : 1.);
-            auto pos {outer.GetPosition()};
-            // Offset is not implicitly corrected if useExt is disabled
-            if(correctOffset)
-                pos += XYZVectorF {0.5, 0.5, 0.5};
-            Q += hitQ;
-            Xm += pos.X() * hitQ;
-            Ym += pos.Y() * hitQ;
-            Zm += pos.Z() * hitQ;
-            Sxx += pos.X() * pos.X() * hitQ;
-            Syy += pos.Y() * pos.Y() * hitQ;
-            Szz += pos.Z() * pos.Z() * hitQ;
-            Sxy += pos.X() * pos.Y() * hitQ;
-            Sxz += pos.X() * pos.Z() * hitQ;
-            Syz += pos.Y() * pos.Z() * hitQ;
-        }
-        else
-        {
-            for(const auto& inner : outer.GetExtended())
-            {
-                const auto& hitQ = (qWeighted ? inner.GetCharge() : 1.);
-                const auto& pos {inner.GetPosition()};
-                // Offset is already corrected in Extended version of a voxel
-                Q += hitQ;
-                Xm += pos.X() * hitQ;
-                Ym += pos.Y() * hitQ;
-                Zm += pos.Z() * hitQ;
-                Sxx += pos.X() * pos.X() * hitQ;
-                Syy += pos.Y() * pos.Y() * hitQ;
-                Szz += pos.Z() * pos.Z() * hitQ;
-                Sxy += pos.X() * pos.Y() * hitQ;
-                Sxz += pos.X() * pos.Z() * hitQ;
-                Syz += pos.Y() * pos.Z() * hitQ;
-            }
-        }
-    }
+    // Paramount importance: use doubles to avoid floating point errors that lead to nans in dim2!!!!
+    double Q {moments.fQ};
+    double Xm {moments.fX};
+    double Ym {moments.fY};
+    double Zm {moments.fZ};
+    double Sxx {moments.fXX};
+    double Syy {moments.fYY};
+    double Szz {moments.fZZ};
+    double Sxy {moments.fXY};
+    double Sxz {moments.fXZ};
+    double Syz {moments.fYZ};
 
     Xm /= Q;
     Ym /= Q;
@@ -200,11 +324,10 @@ void ActRoot::Line::DoFit(const std::vector<ActRoot::Voxel>& voxels, bool qWeigh
         else // handle case with more than one Sii == 0 -> return bad fit
         {
             fDirection = {std::nanf("bad fit"), std::nanf("bad fit"), std::nanf("bad fit")};
-            return;
+            return false;
         }
         // and recompute Chi2 after fitting
-        Chi2Dfrom3D(voxels, correctOffset);
-        return;
+        return true;
     }
     // Doable 3D fit
     theta = 0.5 * std::atan((2. * Sxy) / (Sxx - Syy));
@@ -257,6 +380,7 @@ void ActRoot::Line::DoFit(const std::vector<ActRoot::Voxel>& voxels, bool qWeigh
     XYZPointF Ph = {static_cast<float>(Xh), static_cast<float>(Yh), static_cast<float>(Zh)}; // second point
     SetDirection(fPoint, Ph);
     fChi2 = std::fabs(dm2); // do not divide by charge!
+    return false;
 }
 
 void ActRoot::Line::Fit2Dfrom3D(double Mi, double Mj, double Sii, double Sjj, double Sij, double w,
@@ -310,6 +434,50 @@ void ActRoot::Line::Chi2Dfrom3D(const std::vector<ActRoot::Voxel>& voxels, bool
     fChi2 = std::sqrt(dm2);
 }
 
+void ActRoot::Line::Chi2Dfrom3D(const ActRoot::LineMoments& moments)
+{
+    // Check fit is good
+    if(std::isnan(fDirection.Z()))
+        return;
+    // Same mean squared distance as for the points, from the unweighted moments:
+    // <d^2> = tr(C) - u^T C u, with C the second moments around fPoint and u the unit direction
+    double n {moments.fN};
+    double px {fPoint.X()};
+    double py {fPoint.Y()};
+    double pz {fPoint.Z()};
+    auto central = [n](double sab, double sa, double sb, double pa, double pb)
+    { return sab / n - pa * sb / n - pb * sa / n + pa * pb; };
+    double cxx {central(moments.fUXX, moments.fUX, moments.fUX, px, px)};
+    double cyy {central(moments.fUYY, moments.fUY, moments.fUY, py, py)};
+    double czz {central(moments.fUZZ, moments.fUZ, moments.fUZ, pz, pz)};
+    double cxy {central(moments.fUXY, moments.fUX, moments.fUY, px, py)};
+    double cxz {central(moments.fUXZ, moments.fUX, moments.fUZ, px, pz)};
+    double cyz {central(moments.fUYZ, moments.fUY, moments.fUZ, py, pz)};
+    double mag {std::sqrt(fDirection.Mag2())};
+    double ux {fDirection.X() / mag};
+    double uy {fDirection.Y() / mag};
+    double uz {fDirection.Z() / mag};
+    double dm2 {cxx + cyy + czz -
+                (ux * ux * cxx + uy * uy * cyy + uz * uz * czz + 2. * (ux * uy * cxy + ux * uz * cxz + uy * uz * cyz))};
+    fChi2 = std::sqrt(std::max(dm2, 0.));
+}
+
+void ActRoot::Line::Chi2Dfrom3D(const ActRoot::VoxelCloud& cloud, bool correctOffset)
+{
+    // Check fit is good
+    if(std::isnan(fDirection.Z()))
+        return;
+    float offset {correctOffset ? 0.5f : 0.f};
+    double dm2 {};
+    for(int i = 0, size = cloud.GetSize(); i < size; i++)
+    {
+        XYZPointF pos {cloud.GetX()[i] + offset, cloud.GetY()[i] + offset, cloud.GetZ()[i] + offset};
+        dm2 += std::pow(DistanceLineToPoint(pos), 2);
+    }
+    dm2 /= cloud.GetSize();
+    fChi2 = std::sqrt(dm2);
+}
+
 std::shared_ptr<TPolyLine>
 ActRoot::Line::GetPolyLine(TString proj, int minX, int maxX, int maxY, int maxZ, int rebinZ) const
 {
@@ -2,9 +2,12 @@
 
 #include "ActColors.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <ostream>
 #include <string>
+#include <vector>
 
 bool ActRoot::BinaryData::IsFilled() const
 {
@@ -58,10 +61,12 @@ void ActRoot::MergerData::Clear()
     auto run {fRun};
     auto entry {fEntry};
     auto flag {fFlag};
+    auto flagID {fFlagID};
     *this = MergerData {};
     fRun = run;
     fEntry = entry;
     fFlag = flag;
+    fFlagID = flagID;
 }
 
 void ActRoot::MergerData::Print() const
@@ -94,7 +99,7 @@ void ActRoot::MergerData::Print() const
     std::cout << "   Theta : " << fThetaHeavy << '\n';
     std::cout << "   Phi   : " << fPhiHeavy << '\n';
     fHeavy.Print();
-    std::cout << "-> Flag  : " << fFlag << '\n';
+    std::cout << "-> Flag  : " << GetFlag() << '\n';
     std::cout << "::::::::::::::::::::" << RESET << '\n';
 }
 
@@ -102,3 +107,97 @@ void ActRoot::MergerData::Stream(std::ostream& streamer) const
 {
     streamer << fRun << " " << fEntry << '\n';
 }
+
+const std::vector<std::string>& ActRoot::MergerData::GetFlagTable()
+{
+    // Append new flags at the end: codes are stored in files
+    static const std::vector<std::string> table {"",
+                                                 "ok",
+                                                 "not in GATCONF",
+                                                 "no Beam-like",
+                                                 "no track mult",
+                                                 "no RP",
+                                                 "not Sil mult",
+                                                 "L1 not val",
+                                                 "SP not ok",
+                                                 "SP not matched",
+                                                 "other"};
+    return table;
+}
+
+unsigned char ActRoot::MergerData::GetFlagID(const std::string& flag)
+{
+    const auto& table {GetFlagTable()};
+    auto it {std::find(table.begin(), table.end(), flag)};
+    if(it == table.end())
+        return table.size() - 1; // other
+    return std::distance(table.begin(), it);
+}
+
+std::string ActRoot::MergerData::GetFlag() const
+{
+    if(fFlag.length() || fFlagID >= GetFlagTable().size())
+        return fFlag;
+    return GetFlagTable()[fFlagID];
+}
+
+namespace
+{
+// Members common to MergerData and MergerLeanData
+template <typename From, typename To>
+void CopyCommon(const From& from, To& to)
+{
+    to.fWP = from.fWP;
+    to.fRP = from.fRP;
+    to.fSP = from.fSP;
+    to.fBP = from.fBP;
+    to.fBSP = from.fBSP;
+    to.fBraggP = from.fBraggP;
+    to.fSilLayers = from.fSilLayers;
+    to.fSilEs = from.fSilEs;
+    to.fSilNs = from.fSilNs;
+    to.fFlagID = from.fFlagID;
+    to.fTrackLength = from.fTrackLength;
+    to.fThetaBeam = from.fThetaBeam;
+    to.fThetaBeamZ = from.fThetaBeamZ;
+    to.fPhiBeamY = from.fPhiBeamY;
+    to.fThetaLight = from.fThetaLight;
+    to.fThetaDebug = from.fThetaDebug;
+    to.fThetaLegacy = from.fThetaLegacy;
+    to.fThetaHeavy = from.fThetaHeavy;
+    to.fPhiLight = from.fPhiLight;
+    to.fPhiHeavy = from.fPhiHeavy;
+    to.fQave = from.fQave;
+    to.fLight = from.fLight;
+    to.fHeavy = from.fHeavy;
+    to.fBeamIdx = from.fBeamIdx;
+    to.fLightIdx = from.fLightIdx;
+    to.fHeavyIdx = from.fHeavyIdx;
+    to.fEntry = from.fEntry;
+    to.fRun = from.fRun;
+}
+} // namespace
+
+void ActRoot::MergerLeanData::Clear()
+{
+    *this = MergerLeanData {};
+}
+
+void ActRoot::MergerLeanData::Print() const
+{
+    MergerData data;
+    CopyTo(data);
+    data.Print();
+}
+
+void ActRoot::MergerLeanData::Set(const MergerData& data)
+{
+    CopyCommon(data, *this);
+}
+
+void ActRoot::MergerLeanData::CopyTo(MergerData& data) const
+{
+    data = MergerData {};
+    CopyCommon(*this, data);
+    data.fFlag = data.GetFlag();
+}
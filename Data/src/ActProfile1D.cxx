@@ -0,0 +1,220 @@
+#include "ActProfile1D.h"
+
+#include "TH1.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace
+{
+double Median3(double a, double b, double c)
+{
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+double Median5(const double* x)
+{
+    double v[5] {x[0], x[1], x[2], x[3], x[4]};
+    std::nth_element(v, v + 2, v + 5);
+    return v[2];
+}
+} // namespace
+
+void ActRoot::Profile1D::Reset(int nbins, double xmin, double xmax)
+{
+    fNBins = nbins;
+    fXMin = xmin;
+    fXMax = xmax;
+    fWidth = (xmax - xmin) / nbins;
+    fContent.assign(nbins, 0);
+    fUnderflow = 0;
+    fOverflow = 0;
+    fEntries = 0;
+}
+
+void ActRoot::Profile1D::Fill(double x, double w)
+{
+    fEntries++;
+    // Same bin convention as TAxis::FindBin. Rounding may give fNBins for x just below fXMax: clamp it
+    if(x < fXMin)
+        fUnderflow += w;
+    else if(!(x < fXMax))
+        fOverflow += w;
+    else
+        fContent[std::min(static_cast<int>(fNBins * (x - fXMin) / (fXMax - fXMin)), fNBins - 1)] += w;
+}
+
+int ActRoot::Profile1D::GetMaximumBin() const
+{
+    // First bin with the maximum, as TH1::GetMaximumBin
+    return std::distance(fContent.begin(), std::max_element(fContent.begin(), fContent.end()));
+}
+
+void ActRoot::Profile1D::Smooth()
+{
+    // Same algorithm as TH1::SmoothArray with ntimes = 1
+    int nn {fNBins};
+    if(nn < 3)
+        return;
+    auto& xx {fContent};
+    fYY.resize(nn);
+    fZZ.resize(nn);
+    fRR.resize(nn);
+    auto& yy {fYY};
+    auto& zz {fZZ};
+    auto& rr {fRR};
+    std::copy(xx.begin(), xx.end(), zz.begin());
+    for(int noent = 0; noent < 2; noent++)
+    {
+        // 353: running medians of 3, 5 and 3
+        for(int kk = 0; kk < 3; kk++)
+        {
+            std::copy(zz.begin(), zz.end(), yy.begin());
+            if(kk != 1)
+                for(int i = 1; i < nn - 1; i++)
+                    zz[i] = Median3(yy[i - 1], yy[i], yy[i + 1]);
+            else
+                for(int i = 2; i < nn - 2; i++)
+                    zz[i] = Median5(yy.data() + i - 2);
+            if(kk == 0)
+            {
+                zz[0] = Median3(zz[1], zz[0], 3 * zz[1] - 2 * zz[2]);
+                zz[nn - 1] = Median3(zz[nn - 2], zz[nn - 1], 3 * zz[nn - 2] - 2 * zz[nn - 3]);
+            }
+            if(kk == 1)
+            {
+                zz[1] = Median3(yy[0], yy[1], yy[2]);
+                zz[nn - 2] = Median3(yy[nn - 3], yy[nn - 2], yy[nn - 1]);
+            }
+        }
+        std::copy(zz.begin(), zz.end(), yy.begin());
+        // Q: quadratic interpolation of flat segments
+        for(int i = 2; i < nn - 2; i++)
+        {
+            if(zz[i - 1] != zz[i] || zz[i] != zz[i + 1])
+                continue;
+            double h0 {zz[i - 2] - zz[i]};
+            double h1 {zz[i + 2] - zz[i]};
+            if(h0 * h1 <= 0)
+                continue;
+            int jk {std::abs(h1) > std::abs(h0) ? -1 : 1};
+            yy[i] = -0.5 * zz[i - 2 * jk] + zz[i] / 0.75 + zz[i + 2 * jk] / 6.;
+            yy[i + jk] = 0.5 * (zz[i + 2 * jk] - zz[i - 2 * jk]) + zz[i];
+        }
+        // H: hanning running means
+        for(int i = 1; i < nn - 1; i++)
+            zz[i] = 0.25 * yy[i - 1] + 0.5 * yy[i] + 0.25 * yy[i + 1];
+        zz[0] = yy[0];
+        zz[nn - 1] = yy[nn - 1];
+        // Second pass on residuals
+        if(noent == 0)
+        {
+            std::copy(zz.begin(), zz.end(), rr.begin());
+            for(int i = 0; i < nn; i++)
+                zz[i] = xx[i] - zz[i];
+        }
+    }
+    bool isPositive {*std::min_element(xx.begin(), xx.end()) >= 0};
+    for(int i = 0; i < nn; i++)
+        xx[i] = isPositive ? std::max(rr[i] + zz[i], 0.) : rr[i] + zz[i];
+}
+
+void ActRoot::Profile1D::BuildSpline()
+{
+    // Natural cubic spline (zero second derivative at both ends) on equally spaced knots
+    int n {fNBins};
+    fM.assign(n, 0);
+    if(n < 3)
+        return;
+    // Thomas algorithm for M[i-1] + 4 M[i] + M[i+1] = 6 (y[i+1] - 2 y[i] + y[i-1]) / h^2
+    fYY.resize(n);
+    auto& cp {fYY};
+    double h2 {fWidth * fWidth};
+    cp[0] = 0;
+    for(int i = 1; i < n - 1; i++)
+    {
+        double rhs {6 * (fContent[i + 1] - 2 * fContent[i] + fContent[i - 1]) / h2};
+        double den {4 - cp[i - 1]};
+        cp[i] = 1 / den;
+        fM[i] = (rhs - fM[i - 1]) / den;
+    }
+    for(int i = n - 3; i > 0; i--)
+        fM[i] -= cp[i] * fM[i + 1];
+}
+
+double ActRoot::Profile1D::EvalSpline(double x) const
+{
+    int n {fNBins};
+    double x0 {GetBinCenter(0)};
+    if(n < 2)
+        return n ? fContent[0] : 0;
+    // Segment of x: before first knot the first cubic is extrapolated, after the last one a straight line
+    int i {static_cast<int>(std::floor((x - x0) / fWidth))};
+    i = std::max(0, std::min(i, n - 1));
+    double dx {x - (x0 + i * fWidth)};
+    if(i == n - 1)
+    {
+        double slope {(fContent[n - 1] - fContent[n - 2]) / fWidth + fWidth * (fM[n - 2] + 2 * fM[n - 1]) / 6};
+        return fContent[n - 1] + slope * dx;
+    }
+    double b {(fContent[i + 1] - fContent[i]) / fWidth - fWidth * (2 * fM[i] + fM[i + 1]) / 6};
+    double c {fM[i] / 2};
+    double d {(fM[i + 1] - fM[i]) / (6 * fWidth)};
+    return fContent[i] + dx * (b + dx * (c + dx * d));
+}
+
+double ActRoot::Profile1D::GetX(double y, double xmin, double xmax, int npx)
+{
+    BuildSpline();
+    // Scan for the first interval with a crossing
+    double dx {(xmax - xmin) / (npx - 1)};
+    double xa {xmin};
+    double fa {EvalSpline(xa) - y};
+    double xBest {xa};
+    double fBest {std::abs(fa)};
+    for(int i = 1; i < npx; i++)
+    {
+        double xb {xmin + i * dx};
+        double fb {EvalSpline(xb) - y};
+        if(fa == 0)
+            return xa;
+        if(fa * fb < 0)
+        {
+            // Refine by bisection
+            for(int it = 0; it < 100 && (xb - xa) > 1e-10; it++)
+            {
+                double xm {0.5 * (xa + xb)};
+                double fm {EvalSpline(xm) - y};
+                if(fa * fm <= 0)
+                    xb = xm;
+                else
+                {
+                    xa = xm;
+                    fa = fm;
+                }
+            }
+            return 0.5 * (xa + xb);
+        }
+        if(std::abs(fb) < fBest)
+        {
+            xBest = xb;
+            fBest = std::abs(fb);
+        }
+        xa = xb;
+        fa = fb;
+    }
+    // No crossing: closest point
+    return xBest;
+}
+
+void ActRoot::Profile1D::FillTH1(TH1F& h, const std::string& name, const std::string& title) const
+{
+    h = TH1F {name.c_str(), title.c_str(), fNBins, fXMin, fXMax};
+    h.SetBinContent(0, fUnderflow);
+    for(int i = 0; i < fNBins; i++)
+        h.SetBinContent(i + 1, fContent[i]);
+    h.SetBinContent(fNBins + 1, fOverflow);
+    h.SetEntries(fEntries);
+}
@@ -0,0 +1,85 @@
+#include "ActVoxelCloud.h"
+
+#include "ActVoxel.h"
+
+#include <iostream>
+#include <vector>
+
+void ActRoot::VoxelCloud::Clear()
+{
+    fX.clear();
+    fY.clear();
+    fZ.clear();
+    fQ.clear();
+    fFlags.clear();
+    fZsBegin.resize(1);
+    fZsPool.clear();
+}
+
+void ActRoot::VoxelCloud::Reserve(int n)
+{
+    fX.reserve(n);
+    fY.reserve(n);
+    fZ.reserve(n);
+    fQ.reserve(n);
+    fFlags.reserve(n);
+    fZsBegin.reserve(n + 1);
+}
+
+void ActRoot::VoxelCloud::Add(const Voxel& voxel)
+{
+    const auto& pos {voxel.GetPosition()};
+    fX.push_back(pos.X());
+    fY.push_back(pos.Y());
+    fZ.push_back(pos.Z());
+    fQ.push_back(voxel.GetCharge());
+    fFlags.push_back(voxel.GetIsSaturated() ? kSaturated : 0);
+    const auto& zs {voxel.GetZs()};
+    fZsPool.insert(fZsPool.end(), zs.begin(), zs.end());
+    fZsBegin.push_back(fZsPool.size());
+}
+
+void ActRoot::VoxelCloud::Append(const std::vector<Voxel>& voxels)
+{
+    for(const auto& voxel : voxels)
+        Add(voxel);
+}
+
+void ActRoot::VoxelCloud::Assign(const std::vector<Voxel>& voxels)
+{
+    Clear();
+    Reserve(voxels.size());
+    Append(voxels);
+}
+
+void ActRoot::VoxelCloud::Assign(const std::vector<Voxel>& voxels, const std::vector<int>& order)
+{
+    Clear();
+    Reserve(order.size());
+    for(const auto& i : order)
+        Add(voxels[i]);
+}
+
+ActRoot::Voxel ActRoot::VoxelCloud::GetVoxel(int i) const
+{
+    Voxel ret {GetPosition(i), fQ[i], GetIsSaturated(i)};
+    for(int z = fZsBegin[i]; z < fZsBegin[i + 1]; z++)
+        ret.AddZ(fZsPool[z]);
+    return ret;
+}
+
+std::vector<ActRoot::Voxel> ActRoot::VoxelCloud::ToVoxels() const
+{
+    std::vector<Voxel> ret;
+    ret.reserve(GetSize());
+    for(int i = 0, size = GetSize(); i < size; i++)
+        ret.push_back(GetVoxel(i));
+    return ret;
+}
+
+void ActRoot::VoxelCloud::Print() const
+{
+    std::cout << "===== VoxelCloud =====" << '\n';
+    std::cout << " -> Voxels      : " << GetSize() << '\n';
+    std::cout << " -> Z content   : " << fZsPool.size() << '\n';
+}
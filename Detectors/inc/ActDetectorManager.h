@@ -22,6 +22,7 @@ performed on its data
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace ActRoot
 {
@@ -53,6 +54,8 @@ public:
 
     // Getter of CalibrationManager
     std::shared_ptr<CalibrationManager> GetCalMan() { return fCalMan; }
+    // Use an already read CalibrationManager, e.g. shared with other DetectorManagers. It is used read-only
+    void SetCalMan(std::shared_ptr<CalibrationManager> calman);
 
     // Read configurations
     void ReadDetectorFile(const std::string& file, bool print = true);
@@ -62,6 +65,14 @@ public:
     // Set input and output data
     void InitInput(std::shared_ptr<TTree> input);
     void InitOutput(std::shared_ptr<TTree> output);
+    // One tree per output of DataManager::GetOutputModes()
+    void InitOutput(const std::vector<std::shared_ptr<TTree>>& outputs);
+    //! In-memory chain of ESimuReco mode: simulated MEventReduced -> TPCData -> filter -> MergerData
+    /*!
+      Only MergerData is written to output (if any). For each event, the simulation fills mevent and
+      clears and fills SilData and ModularData of the corresponding detectors before calling BuildEvent
+    */
+    void InitSimuReco(MEventReduced* mevent, std::shared_ptr<TTree> output = nullptr);
 
     // Build functions
     void BuildEvent(const int& run, const int& entry);
@@ -105,6 +116,8 @@ private:
     void InitMerger(bool print);
     void SendParametersToMerger();
     void InitCorr(bool print);
+    void ShareMEvent();
+    void BuildRawEvent(int run, int entry);
 };
 } // namespace ActRoot
 #endif
@@ -44,6 +44,7 @@ class TPCData;
 class SilData;
 class ModularData;
 class MergerData;
+class MergerLeanData;
 class InputWrapper
 {
 private:
@@ -57,6 +58,7 @@ private:
     ModularData* fModularData {};
     // Merger data
     MergerData* fMergerData {};
+    MergerLeanData* fLeanData {}; //!< Read instead of fMergerData in runs with lean output
 
 public:
     InputWrapper() = default;
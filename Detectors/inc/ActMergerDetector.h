@@ -6,6 +6,7 @@
 #include "ActMergerData.h"
 #include "ActMergerParameters.h"
 #include "ActModularData.h"
+#include "ActProfile1D.h"
 #include "ActSilData.h"
 #include "ActSilSpecs.h"
 #include "ActTPCData.h"
@@ -56,6 +57,8 @@ private:
     // Merger
     MergerParameters fPars {};
     MergerData* fMergerData {};
+    MergerLeanData* fLeanData {}; //!< Copy of fMergerData in lean files, written or read
+    bool fLeanInput {};           //!< Input filter is a lean file
 
     // Flags to delete news in destructor
     bool fDelTPCSilMod {};
@@ -92,6 +95,8 @@ private:
     bool fEnableQProfile {};
     bool f2DProfile {};
     bool fEnableRootFind {};
+    bool fStoreProfiles {}; //!< Copy profiles as TH1F into MergerData
+    bool fLeanOutput {};    //!< Write MergerLeanData: without profiles nor flag strings
     // Fallback to default beam
     bool fEnableDefaultBeam {};
     double fDefaultBeamXThresh {};
@@ -100,6 +105,8 @@ private:
     // Validation of L1 trigger
     bool fEnableL1Validation {};
     double fL1ExclusionZone {}; //!< Validating L1 means fLightPtr does not reach boundaries of TPC
+    // Reject events from Sil and Modular data before filtering TPC
+    bool fEnablePreSelection {};
 
     // Store pointers to beam, light and heavy
     ActRoot::Cluster* fBeamPtr;
@@ -109,6 +116,12 @@ private:
     // Time counting
     std::vector<TStopwatch> fClocks {};
     std::vector<std::string> fClockLabels {};
+    unsigned long fNPreSelected {};
+    unsigned long fNPreRejected {};
+
+    // Charge profiles reused between events
+    Profile1D fQProfile {};
+    Profile1D fXProfile {};
 
 public:
     MergerDetector(); //!< Default constructor that sets verbose mode according to ActRoot::Options
@@ -185,9 +198,17 @@ public:
     // Getter of status
     bool GetIsEnabled() const { return fIsEnabled; }
 
+    //! Whether the MergerData branch of tree holds a MergerLeanData
+    static bool HasLeanData(TTree* tree);
+    //! Throws if a lean tree has branches of profiles or flag string, or any branch with other entries than tree
+    static void CheckLeanTree(TTree* tree);
+
     // Getter of sil specs
     std::shared_ptr<ActPhysics::SilSpecs> GetSilSpecs() const { return fSilSpecs; }
 
+    // Cheap check of GATCONF and silicon gates before TPC filter. False if the event can never pass IsDoable
+    bool PreSelect(int run, int entry);
+
     // Methods particular to this detector
     void SetDriftFactor(double factor) { fDriftFactor = factor; }
     double GetDriftFactor() const { return fDriftFactor; }
@@ -195,6 +216,8 @@ public:
 private:
     void InitCorrector();
     void InitClocks();
+    void InitMergerOutput(std::shared_ptr<TTree> tree);
+    void FillLeanData();
     void ReadSilSpecs(const std::string& file);
     void DoMerge();
     void AddPredefinedTasks();
@@ -203,6 +226,7 @@ private:
     bool ConvertToPhysicalUnits();
     bool GateGATCONFandTrackMult();
     bool GateSilMult();
+    bool PreGateSilMult(const std::vector<std::string>& layers, bool isL1);
     bool LightOrHeavy();
     bool ValidateL1();
     bool ComputeOtherPoints();
@@ -227,7 +251,7 @@ private:
     {
         return std::find(vec.begin(), vec.end(), val) != vec.end();
     }
-    double GetRangeFromProfile(TH1F* h, bool smooth = true);
+    double GetRangeFromProfile(Profile1D& profile, bool smooth = true);
     bool DefaultBeamDirection();
 };
 } // namespace ActRoot
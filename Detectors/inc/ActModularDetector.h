@@ -46,6 +46,8 @@ public:
     // Builders
     void BuildEventData(int run = -1, int entry = -1) override;
     void BuildEventFilter() override;
+    // Single-pass raw decoding: read one channel of CoBo 31
+    void ReadChannel(ReducedData& coas);
 
     // Cleaners
     void ClearEventData() override;
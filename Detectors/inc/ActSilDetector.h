@@ -9,11 +9,25 @@
 
 #include "TTree.h"
 
+#include <string>
+#include <vector>
+
 namespace ActRoot
 {
 //! Silicon detector class
 class SilDetector : public VDetector
 {
+public:
+    //! Silicon and calibration handles of a VXI channel, resolved once instead of for every hit
+    class Channel
+    {
+    public:
+        std::string fLayer {};
+        int fSil {-1};
+        int fThresh {-1}; //!< Handle of threshold in CalibrationManager
+        int fCal {-1};    //!< Handle of calibration in CalibrationManager
+    };
+
 private:
     // Parameters
     SilParameters fPars; //!< Basic detector configurations
@@ -21,6 +35,10 @@ private:
     MEventReduced* fMEvent {};
     // Data
     SilData* fData {}; //!< Pointer to SilData
+    // Channel table
+    std::vector<Channel> fChannels {};       //!< Indexed by VXI - fMinVXI
+    int fMinVXI {};
+    CalibrationManager* fChannelsCalMan {}; //!< CalibrationManager whose handles are in fChannels
 
     // Set flags to delete new in destructor
     bool fDelMEvent {};
@@ -45,6 +63,10 @@ public:
     // Builders
     void BuildEventData(int run = -1, int entry = -1) override;
     void BuildEventFilter() override;
+    // Single-pass raw decoding: read one channel of CoBo 31
+    void ReadChannel(ReducedData& coas);
+    // Resolve calibration keys of every channel (otherwise done on first event)
+    void InitChannels();
 
     // Cleaners
     void ClearEventData() override;
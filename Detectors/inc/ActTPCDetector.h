@@ -2,6 +2,7 @@
 #define ActTPCDetector_h
 
 #include "ActModularParameters.h"
+#include "ActRandomStream.h"
 #include "ActTPCData.h"
 #include "ActTPCLegacyData.h"
 #include "ActTPCParameters.h"
@@ -55,6 +56,8 @@ private:
     std::shared_ptr<ActAlgorithm::VCluster> fCluster {};
     // Filter method
     std::shared_ptr<ActAlgorithm::VFilter> fFilter {};
+    // Random numbers of algorithms, keyed by (run, entry)
+    RandomStream fRand {};
 
     // Pointer to ModularParameters to append any labels if needed
     std::shared_ptr<ModularParameters> fModularPars {};
@@ -86,6 +89,9 @@ public:
     // Builders
     void BuildEventData(int run = -1, int entry = -1) override;
     void BuildEventFilter() override;
+    // Single-pass raw decoding: read one channel of CoBo co, then build clusters once all are read
+    void ReadChannel(ReducedData& coas, int co);
+    void EndEventData();
 
     // Cleaners
     void ClearEventData() override;
@@ -117,6 +123,9 @@ public:
     // Others
     std::shared_ptr<ActAlgorithm::VCluster> GetCluster() const { return fCluster; }
     std::shared_ptr<ActAlgorithm::VFilter> GetFilter() const { return fFilter; }
+    RandomStream& GetRandom() { return fRand; }
+    // Set current event in random stream and filter
+    void SetEvent(int run, int entry);
 
     template <typename T>
     std::shared_ptr<T> GetClusterAs() const
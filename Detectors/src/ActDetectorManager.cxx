@@ -56,12 +56,20 @@ void ActRoot::DetectorManager::InitDetectors()
         // Modular
         fDetectors[DetectorType::EModular] = std::make_shared<ActRoot::ModularDetector>();
     }
+    else if(fMode == ModeType::EReadAll)
+    {
+        // All of them share the MEventReduced read by TPC
+        fDetectors[DetectorType::EActar] = std::make_shared<ActRoot::TPCDetector>();
+        fDetectors[DetectorType::ESilicons] = std::make_shared<ActRoot::SilDetector>();
+        fDetectors[DetectorType::EModular] = std::make_shared<ActRoot::ModularDetector>();
+    }
     else if(fMode == ModeType::EFilter)
     {
         // Filter mode refers to filter at first stage: TPC -> Merger
         fDetectors[DetectorType::EActar] = std::make_shared<ActRoot::TPCDetector>();
     }
-    else if(fMode == ModeType::EMerge || fMode == ModeType::EFilterMerge || fMode == ModeType::EGui)
+    else if(fMode == ModeType::EMerge || fMode == ModeType::EFilterMerge || fMode == ModeType::EGui ||
+            fMode == ModeType::ESimuReco)
     {
         fDetectors[DetectorType::EActar] = std::make_shared<ActRoot::TPCDetector>();
         fDetectors[DetectorType::ESilicons] = std::make_shared<ActRoot::SilDetector>();
@@ -96,7 +104,8 @@ void ActRoot::DetectorManager::ReadDetectorFile(const std::string& file, bool pr
     }
     // Workaround for Merger: needs access to all the other parameters
     // but not for its filter (ModeType::ECorrect)
-    if(fMode == ModeType::EMerge || fMode == ModeType::EFilterMerge || fMode == ModeType::EGui)
+    if(fMode == ModeType::EMerge || fMode == ModeType::EFilterMerge || fMode == ModeType::EGui ||
+       fMode == ModeType::ESimuReco)
     {
         auto merger {std::dynamic_pointer_cast<ActRoot::MergerDetector>(fDetectors[DetectorType::EMerger])};
         for(auto& [key, det] : fDetectors)
@@ -120,6 +129,12 @@ void ActRoot::DetectorManager::ReadDetectorFile(const std::string& file, bool pr
         // Delete Modular detector
         DeleteDetector(DetectorType::EModular);
     }
+    // In single-pass mode, Modular is kept to write ModularData
+    if(fMode == ModeType::EReadAll && ActRoot::Options::GetInstance()->GetWithTrigger())
+    {
+        auto pars {dynamic_cast<ModularParameters*>(fDetectors[DetectorType::EModular]->GetParameters())};
+        GetDetectorAs<TPCDetector>()->SetModularParameters(std::make_shared<ModularParameters>(*pars));
+    }
 
 
     // Move print to here
@@ -140,6 +155,16 @@ void ActRoot::DetectorManager::ReadCalibrationsFile(const std::string& file)
         if(std::find(headers.begin(), headers.end(), str) != headers.end())
             det->ReadCalibrations(parser.GetBlock(str));
     }
+    // Register silicon keys now, so the CalibrationManager is not modified while building events
+    if(fDetectors.count(DetectorType::ESilicons))
+        GetDetectorAs<SilDetector>()->InitChannels();
+}
+
+void ActRoot::DetectorManager::SetCalMan(std::shared_ptr<CalibrationManager> calman)
+{
+    fCalMan = calman;
+    for(auto& [key, det] : fDetectors)
+        det->SetCalMan(fCalMan);
 }
 
 void ActRoot::DetectorManager::Reconfigure()
@@ -165,6 +190,8 @@ void ActRoot::DetectorManager::InitInput(std::shared_ptr<TTree> input)
     if(fMode == ModeType::EReadTPC || fMode == ModeType::EReadSilMod)
         for(auto& [key, det] : fDetectors)
             det->InitInputData(input);
+    else if(fMode == ModeType::EReadAll)
+        fDetectors[DetectorType::EActar]->InitInputData(input);
     else if(fMode == ModeType::EFilter)
         for(auto& [key, det] : fDetectors)
             det->InitInputFilter(input);
@@ -186,6 +213,8 @@ void ActRoot::DetectorManager::InitInput(std::shared_ptr<TTree> input)
     // Workaround for EData mode
     if(fMode == ModeType::EReadSilMod)
         fDetectors[DetectorType::EModular]->SetMEvent(fDetectors[DetectorType::ESilicons]->GetMEvent());
+    if(fMode == ModeType::EReadAll)
+        ShareMEvent();
 }
 
 void ActRoot::DetectorManager::InitOutput(std::shared_ptr<TTree> output)
@@ -206,14 +235,93 @@ void ActRoot::DetectorManager::InitOutput(std::shared_ptr<TTree> output)
                                  ActRoot::Options::GetModeStr(fMode));
 }
 
+void ActRoot::DetectorManager::InitOutput(const std::vector<std::shared_ptr<TTree>>& outputs)
+{
+    if(fMode != ModeType::EReadAll)
+    {
+        if(outputs.size() != 1)
+            throw std::runtime_error("DetectorManager::InitOutput(): mode " + ActRoot::Options::GetModeStr(fMode) +
+                                     " writes a single output");
+        InitOutput(outputs.front());
+        return;
+    }
+    // Single pass writes Cluster (TPC) and Data (Sil and Modular) tiers
+    if(outputs.size() != 2)
+        throw std::runtime_error("DetectorManager::InitOutput(): ReadAll mode requires Cluster and Data outputs");
+    fDetectors[DetectorType::EActar]->InitOutputData(outputs[0]);
+    fDetectors[DetectorType::ESilicons]->InitOutputData(outputs[1]);
+    fDetectors[DetectorType::EModular]->InitOutputData(outputs[1]);
+}
+
+void ActRoot::DetectorManager::InitSimuReco(MEventReduced* mevent, std::shared_ptr<TTree> output)
+{
+    if(fMode != ModeType::ESimuReco)
+        throw std::runtime_error("DetectorManager::InitSimuReco(): only available in " +
+                                 ActRoot::Options::GetModeStr(ModeType::ESimuReco) + " mode");
+    auto merger {GetDetectorAs<MergerDetector>()};
+    // TPC reads the MEventReduced of the simulation
+    fDetectors[DetectorType::EActar]->SetMEvent(mevent);
+    // TPCData, SilData and ModularData are only kept in memory, owned by each detector and read by Merger
+    for(auto type : {DetectorType::EActar, DetectorType::ESilicons, DetectorType::EModular})
+    {
+        fDetectors[type]->InitOutputData(nullptr);
+        merger->SetInputData(fDetectors[type]->GetOutputData());
+    }
+    // Only MergerData is written, next to the simulation branches of the same tree
+    merger->InitOutputData(output);
+}
+
+void ActRoot::DetectorManager::ShareMEvent()
+{
+    auto* mevent {fDetectors[DetectorType::EActar]->GetMEvent()};
+    fDetectors[DetectorType::ESilicons]->SetMEvent(mevent);
+    fDetectors[DetectorType::EModular]->SetMEvent(mevent);
+}
+
+void ActRoot::DetectorManager::BuildRawEvent(int run, int entry)
+{
+    auto tpc {GetDetectorAs<TPCDetector>()};
+    auto sil {GetDetectorAs<SilDetector>()};
+    auto mod {GetDetectorAs<ModularDetector>()};
+    tpc->SetEvent(run, entry);
+    for(auto& [key, det] : fDetectors)
+        det->ClearEventData();
+    // Demultiplex by CoBo: 31 holds VXI (silicons, modular and trigger), the rest are pads
+    for(auto& coas : tpc->GetMEvent()->CoboAsad)
+    {
+        int co {coas.globalchannelid >> 11};
+        if(co == 31)
+        {
+            sil->ReadChannel(coas);
+            mod->ReadChannel(coas);
+        }
+        tpc->ReadChannel(coas, co);
+    }
+    tpc->EndEventData();
+}
+
 void ActRoot::DetectorManager::BuildEvent(const int& run, const int& entry)
 {
+    // Input pointers may be swapped by InputData prefetching: refresh the ones shared between detectors
+    if(fMode == ModeType::EReadSilMod)
+        fDetectors[DetectorType::EModular]->SetMEvent(fDetectors[DetectorType::ESilicons]->GetMEvent());
+    else if(fMode == ModeType::EReadAll)
+        ShareMEvent();
+    else if(fMode == ModeType::EFilterMerge)
+        fDetectors[DetectorType::EActar]->SetInputFilter(GetDetectorAs<MergerDetector>()->GetInputData<TPCData>());
+
+    // Random numbers of TPC algorithms only depend on the event, not on the thread
+    if(fMode == ModeType::EFilter || fMode == ModeType::EFilterMerge || fMode == ModeType::ESimuReco)
+        GetDetectorAs<TPCDetector>()->SetEvent(run, entry);
+
     if(fMode == ModeType::EReadTPC || fMode == ModeType::EReadSilMod)
         for(auto& [key, det] : fDetectors)
         {
             det->ClearEventData();
-            det->BuildEventData();
+            det->BuildEventData(run, entry);
         }
+    else if(fMode == ModeType::EReadAll)
+        BuildRawEvent(run, entry);
     else if(fMode == ModeType::EFilter)
         for(auto& [key, det] : fDetectors)
         {
@@ -227,10 +335,29 @@ void ActRoot::DetectorManager::BuildEvent(const int& run, const int& entry)
     }
     else if(fMode == ModeType::EFilterMerge)
     {
+        fDetectors[DetectorType::EMerger]->ClearEventData();
+        // Skip TPC filter and merging if Sil and Modular data already reject the event
+        if(!GetDetectorAs<MergerDetector>()->PreSelect(run, entry))
+            return;
+
         fDetectors[DetectorType::EActar]->ClearEventFilter();
         fDetectors[DetectorType::EActar]->BuildEventFilter();
 
+        fDetectors[DetectorType::EMerger]->BuildEventData(run, entry);
+    }
+    else if(fMode == ModeType::ESimuReco)
+    {
+        // MEventReduced, SilData and ModularData have already been filled by the simulation
         fDetectors[DetectorType::EMerger]->ClearEventData();
+        if(!GetDetectorAs<MergerDetector>()->PreSelect(run, entry))
+            return;
+
+        auto& tpc {fDetectors[DetectorType::EActar]};
+        tpc->ClearEventData();
+        tpc->BuildEventData(run, entry);
+        tpc->ClearEventFilter();
+        tpc->BuildEventFilter();
+
         fDetectors[DetectorType::EMerger]->BuildEventData(run, entry);
     }
     else if(fMode == ModeType::EGui)
@@ -3,6 +3,7 @@
 #include "ActColors.h"
 #include "ActInputData.h"
 #include "ActMergerData.h"
+#include "ActMergerDetector.h"
 #include "ActModularData.h"
 #include "ActSilData.h"
 #include "ActTPCData.h"
@@ -221,11 +222,14 @@ ActRoot::InputWrapper::~InputWrapper()
         delete fModularData;
     if(fMergerData)
         delete fMergerData;
+    delete fLeanData;
 }
 
 void ActRoot::InputWrapper::GetEntry(int run, int entry)
 {
     fInput->GetEntry(run, entry);
+    if(fLeanData && fMergerData)
+        fLeanData->CopyTo(*fMergerData);
     // Reset not read from file class members
     std::vector<VData*> datas {fTPCData, fSilData, fModularData, fMergerData};
     for(auto* data : datas)
@@ -295,7 +299,16 @@ void ActRoot::InputWrapper::SetBranchAddress(int run)
         tree->SetBranchAddress("SilData", &fSilData);
     if(tree->FindBranch("ModularData"))
         tree->SetBranchAddress("ModularData", &fModularData);
-    if(tree->FindBranch("MergerData"))
+    // Lean output is read into its own class and copied to fMergerData in GetEntry
+    delete fLeanData;
+    fLeanData = nullptr;
+    if(tree->FindBranch("MergerData") && MergerDetector::HasLeanData(tree.get()))
+    {
+        MergerDetector::CheckLeanTree(tree.get());
+        fLeanData = new MergerLeanData;
+        tree->SetBranchAddress("MergerData", &fLeanData);
+    }
+    else if(tree->FindBranch("MergerData"))
         tree->SetBranchAddress("MergerData", &fMergerData);
 }
 
@@ -17,12 +17,13 @@
 #include "ActTypes.h"
 #include "ActVoxel.h"
 
+#include "TBranchElement.h"
 #include "TError.h"
-#include "TF1.h"
 #include "TH1.h"
+#include "TLeaf.h"
 #include "TMath.h"
 #include "TMathBase.h"
-#include "TSpline.h"
+#include "TNamed.h"
 #include "TStopwatch.h"
 #include "TTree.h"
 
@@ -64,6 +65,8 @@ ActRoot::MergerDetector::~MergerDetector()
         delete fMergerData;
         fMergerData = nullptr;
     }
+    delete fLeanData;
+    fLeanData = nullptr;
 }
 
 void ActRoot::MergerDetector::ReadConfiguration(std::shared_ptr<InputBlock> block)
@@ -111,6 +114,12 @@ void ActRoot::MergerDetector::ReadConfiguration(std::shared_ptr<InputBlock> bloc
         f2DProfile = block->GetBool("2DProfile");
     if(block->CheckTokenExists("EnableRootFind", !fIsEnabled))
         fEnableRootFind = block->GetBool("EnableRootFind");
+    // Profiles are always needed in GUI to be drawn
+    fStoreProfiles = ActRoot::Options::GetInstance()->GetMode() == ModeType::EGui;
+    if(block->CheckTokenExists("StoreProfiles", true))
+        fStoreProfiles = block->GetBool("StoreProfiles");
+    if(block->CheckTokenExists("LeanOutput", true))
+        fLeanOutput = block->GetBool("LeanOutput");
     if(block->CheckTokenExists("EnableDefaultBeam", !fIsEnabled))
         fEnableDefaultBeam = block->GetBool("EnableDefaultBeam");
     if(block->CheckTokenExists("DefaultBeamXThresh", !fEnableDefaultBeam))
@@ -121,6 +130,8 @@ void ActRoot::MergerDetector::ReadConfiguration(std::shared_ptr<InputBlock> bloc
         fEnableL1Validation = block->GetBool("EnableL1Validation");
     if(block->CheckTokenExists("L1ExclusionZone"))
         fL1ExclusionZone = block->GetDouble("L1ExclusionZone");
+    if(block->CheckTokenExists("EnablePreSelection", true))
+        fEnablePreSelection = block->GetBool("EnablePreSelection");
 
     // Build or not filter method
     if(ActRoot::Options::GetInstance()->GetMode() == ModeType::ECorrect)
@@ -222,14 +233,79 @@ void ActRoot::MergerDetector::InitInputFilter(std::shared_ptr<TTree> tree)
     if(fMergerData)
         delete fMergerData;
     fMergerData = new MergerData;
-    tree->SetBranchAddress("MergerData", &fMergerData);
+    // Lean files are read into fLeanData and copied to fMergerData in BuildEventFilter
+    fLeanInput = HasLeanData(tree.get());
+    if(fLeanInput)
+    {
+        CheckLeanTree(tree.get());
+        if(!fLeanData)
+            fLeanData = new MergerLeanData;
+        tree->SetBranchAddress("MergerData", &fLeanData);
+    }
+    else
+        tree->SetBranchAddress("MergerData", &fMergerData);
     // Set to delete
     fDelMerger = true;
 }
 
 void ActRoot::MergerDetector::InitOutputFilter(std::shared_ptr<TTree> tree)
 {
-    tree->Branch("MergerData", &fMergerData);
+    InitMergerOutput(tree);
+}
+
+void ActRoot::MergerDetector::InitMergerOutput(std::shared_ptr<TTree> tree)
+{
+    if(!fLeanOutput)
+    {
+        tree->Branch("MergerData", &fMergerData);
+        return;
+    }
+    // Same branch name but another class: profiles and flag string are not even created
+    if(!fLeanData)
+        fLeanData = new MergerLeanData;
+    tree->Branch("MergerData", &fLeanData);
+    // Dictionary of fFlagID stored along the tree, as "id:flag" separated by ';'
+    std::string dict {};
+    const auto& table {MergerData::GetFlagTable()};
+    for(int i = 0, size = table.size(); i < size; i++)
+        dict += std::to_string(i) + ":" + table[i] + ";";
+    tree->GetUserInfo()->Add(new TNamed("MergerFlags", dict.c_str()));
+}
+
+void ActRoot::MergerDetector::FillLeanData()
+{
+    if(fLeanOutput)
+        fLeanData->Set(*fMergerData);
+}
+
+bool ActRoot::MergerDetector::HasLeanData(TTree* tree)
+{
+    auto branch {dynamic_cast<TBranchElement*>(tree->GetBranch("MergerData"))};
+    return branch && std::string {branch->GetClassName()} == "ActRoot::MergerLeanData";
+}
+
+void ActRoot::MergerDetector::CheckLeanTree(TTree* tree)
+{
+    if(!HasLeanData(tree))
+        throw std::runtime_error("MergerDetector::CheckLeanTree(): tree " + std::string {tree->GetName()} +
+                                 " has no MergerLeanData");
+    auto entries {tree->GetEntries()};
+    std::string errors {};
+    for(auto* obj : *tree->GetListOfLeaves())
+    {
+        auto branch {static_cast<TLeaf*>(obj)->GetBranch()};
+        std::string name {branch->GetName()};
+        // Split branches of a top-level branch without trailing dot have no prefix
+        if(name.find("MergerData.") == 0)
+            name.erase(0, std::string {"MergerData."}.length());
+        if(name == "fFlag" || name.find("fQprojX") == 0 || name.find("fQProf") == 0)
+            errors += " " + name + " is not lean;";
+        else if(branch->GetEntries() != entries)
+            errors += " " + name + " has " + std::to_string(branch->GetEntries()) + " entries;";
+    }
+    if(errors.length())
+        throw std::runtime_error("MergerDetector::CheckLeanTree(): tree with " + std::to_string(entries) +
+                                 " entries:" + errors);
 }
 
 void ActRoot::MergerDetector::InitInputData(std::shared_ptr<TTree> tree)
@@ -263,7 +339,7 @@ void ActRoot::MergerDetector::InitOutputData(std::shared_ptr<TTree> tree)
         delete fMergerData;
     fMergerData = new MergerData;
     if(tree)
-        tree->Branch("MergerData", &fMergerData);
+        InitMergerOutput(tree);
 
     // Set to delete this
     fDelMerger = true;
@@ -278,11 +354,17 @@ void ActRoot::MergerDetector::ReadSilSpecs(const std::string& file)
 
 void ActRoot::MergerDetector::BuildEventFilter()
 {
+    if(fLeanInput)
+        fLeanData->CopyTo(*fMergerData);
     if(fFilter)
     {
         fFilter->SetMergerData(fMergerData);
         fFilter->Run();
     }
+    // Encoded after the filter, which may rewrite fFlag. Files without fFlagID have it encoded here
+    if(fMergerData->fFlag.length())
+        fMergerData->EncodeFlag();
+    FillLeanData();
 }
 
 
@@ -322,6 +404,8 @@ void ActRoot::MergerDetector::BuildEventData(int run, int entry)
     Reset(run, entry);
     // Merge
     DoMerge();
+    fMergerData->EncodeFlag();
+    FillLeanData();
 }
 
 bool ActRoot::MergerDetector::IsDoable()
@@ -502,6 +586,80 @@ bool ActRoot::MergerDetector::GateSilMult()
     }
 }
 
+bool ActRoot::MergerDetector::PreSelect(int run, int entry)
+{
+    if(!fIsEnabled || !fEnablePreSelection)
+        return true;
+    // Same conditions as in IsDoable but only those not depending on the TPC
+    // 1-> GATCONF
+    bool isL1 {};
+    std::vector<std::string> layers {};
+    std::string flag {};
+    if(fForceGATCONF)
+    {
+        auto it {fGatMap.find((int)fModularData->Get("GATCONF"))};
+        if(it == fGatMap.end())
+            flag = "not in GATCONF";
+        else
+        {
+            isL1 = IsInVector({"L1"}, it->second);
+            layers = it->second;
+        }
+    }
+    else
+        layers = fSilData->GetLayers();
+    // 2-> Silicon multiplicity. Calibration mode depends on the number of clusters after filtering,
+    // so if it is possible the event passes as long as it has any silicon data
+    if(flag.empty())
+    {
+        bool canBeCal {!fForceRP && !isL1};
+        bool passCal {canBeCal && fSilData->fSiE.size() > 0};
+        if(!passCal && !PreGateSilMult(layers, isL1))
+            flag = "not Sil mult";
+    }
+    if(flag.empty())
+    {
+        fNPreSelected++;
+        return true;
+    }
+    fNPreRejected++;
+    Reset(run, entry);
+    fMergerData->fFlag = flag;
+    fMergerData->EncodeFlag();
+    FillLeanData();
+    if(fIsVerbose)
+        std::cout << BOLDRED << "  Event rejected in pre-selection: " << flag << RESET << '\n';
+    return false;
+}
+
+bool ActRoot::MergerDetector::PreGateSilMult(const std::vector<std::string>& layers, bool isL1)
+{
+    // As GateSilMult without calibration mode, but counting hits over finer thresholds without modifying SilData
+    int withHits {};
+    int withMult {};
+    for(const auto& layer : layers)
+    {
+        if(!fSilSpecs->CheckLayersExists(layer))
+            continue;
+        auto itE {fSilData->fSiE.find(layer)};
+        auto itN {fSilData->fSiN.find(layer)};
+        if(itE == fSilData->fSiE.end() || itN == fSilData->fSiN.end())
+            continue;
+        const auto& specs {fSilSpecs->GetLayer(layer)};
+        int mult {};
+        for(int i = 0, size = itE->second.size(); i < size; i++)
+            if(specs.ApplyThreshold(itN->second[i], itE->second[i]))
+                mult++;
+        if(mult > 0)
+        {
+            withHits++;
+            if(specs.CheckMult(mult))
+                withMult++;
+        }
+    }
+    return (withHits == withMult) && (isL1 || withHits > 0);
+}
+
 void ActRoot::MergerDetector::Reset(const int& run, const int& entry)
 {
     // Reset parameters
@@ -1192,43 +1350,51 @@ bool ActRoot::MergerDetector::ComputeQProfile()
         int nBins {std::max(
             2, int(std::ceil((rangeHisto + safeDistanceHisto) / ds)))}; // nBins depend on the step and TL - min of 2 to
                                                                         // avoid probles with spline interpolation
-        // 1.1-> Init the histogram
-        TH1F h {"hQProfile", "QProfile", nBins, -safeDistanceHisto, 265 + 5};
-        TString units {fEnableConversion ? "mm" : "pad units"};
-        h.SetTitle(Form("QProfile;dist [%s];Q [au]", units.Data()));
-        // Use 3 divisions to get better resolution
-        float div {1.f / 3};
+        // 1.1-> Init the profile
+        fQProfile.Reset(nBins, -safeDistanceHisto, 265 + 5);
+        // 2-> Spread each voxel in 3 divisions per axis (9 in 2D). Projections are linear, so the position
+        // along the line of each sub-voxel is that of the voxel center plus an offset that only depends on the
+        // direction. Distance to ref follows from the position t along the line and the offset of ref to it
+        auto dir {line.GetDirection().Unit()};
+        double sxy {fEnableConversion ? fTPCPars->GetPadSide() : 1.};
+        double sz {f2DProfile ? 0. : (fEnableConversion ? fDriftFactor : 1.)};
+        double ux {sxy * dir.X()};
+        double uy {sxy * dir.Y()};
+        double uz {sz * dir.Z()};
+        double div {1. / 3};
+        int nSub {(f2DProfile) ? 9 : 27};
+        double offsets[27] {};
+        int n {};
+        for(int ix = -1; ix < 2; ix++)
+            for(int iy = -1; iy < 2; iy++)
+                for(int iz = -1; iz < 2; iz++)
+                {
+                    offsets[n++] = div * (ix * ux + iy * uy + iz * uz);
+                    if(f2DProfile)
+                        break;
+                }
+        const auto& p0 {line.GetPoint()};
+        XYZVector w {p0 - ref};
+        double wu {w.Dot(dir)};
+        double perp2 {std::max(w.Mag2() - wu * wu, 0.)};
         for(const auto& v : fLightPtr->GetVoxels())
         {
             const auto& pos {v.GetPosition()};
-            auto q {v.GetCharge()};
-            // Run for 3 divisions
-            for(int ix = -1; ix < 2; ix++)
+            // Position of voxel center along the line, measured from the projection of ref
+            double t {((pos.X() + 0.5) * sxy - p0.X()) * dir.X() + ((pos.Y() + 0.5) * sxy - p0.Y()) * dir.Y() +
+                      ((pos.Z() + 0.5) * sz - p0.Z()) * dir.Z() + wu};
+            auto q {v.GetCharge() / nSub};
+            for(int s = 0; s < nSub; s++)
             {
-                for(int iy = -1; iy < 2; iy++)
-                {
-                    for(int iz = -1; iz < 2; iz++)
-                    {
-                        XYZPoint bin {(pos.X() + 0.5f) + ix * div, (pos.Y() + 0.5f) + iy * div,
-                                      (f2DProfile) ? 0.f : (pos.Z() + 0.5f) + iz * div};
-                        // Convert to physical units
-                        if(fEnableConversion)
-                            ScalePoint(bin, fTPCPars->GetPadSide(), fDriftFactor,
-                                       false); // false bc +0.5 already considered
-                        // Project it on line
-                        auto proj {line.ProjectionPointOnLine(bin)};
-                        // Fill histograms
-                        auto dist {(proj - ref).R()};
-                        h.Fill(dist, q / ((f2DProfile) ? 9 : 27));
-                        if(f2DProfile)
-                            break;
-                    }
-                }
+                double ts {t + offsets[s]};
+                fQProfile.Fill(std::sqrt(ts * ts + perp2), q);
             }
         }
-        fMergerData->fQProf = h;
+        if(fStoreProfiles)
+            fQProfile.FillTH1(fMergerData->fQProf, "hQProfile",
+                              fEnableConversion ? "QProfile;dist [mm];Q [au]" : "QProfile;dist [pad units];Q [au]");
         // Compute range from profile
-        auto range {GetRangeFromProfile(&h)};
+        auto range {GetRangeFromProfile(fQProfile)};
         // And move to point
         fMergerData->fBraggP = ref + range * line.GetDirection().Unit();
         if(fIsVerbose)
@@ -1283,7 +1449,7 @@ bool ActRoot::MergerDetector::ComputeXProfile()
         bool isOkOther {(fPars.fIsCal || fPars.fIsL1) && fLightPtr != nullptr};
         if(isOkReaction || isOkOther)
         {
-            TH1F hQprojX {"hQProjX", "All Q along X;X [pad];Q_{proj X}", 128, 0, 128};
+            fXProfile.Reset(128, 0, 128);
             std::vector<ActRoot::Cluster*> ptrs {fBeamPtr, fLightPtr, fHeavyPtr};
             // Workaround: we analyze all the tracks in the event to find the BSP or compute the X profile
             // if(isOkReaction)
@@ -1296,13 +1462,14 @@ bool ActRoot::MergerDetector::ComputeXProfile()
                 if(!ptr)
                     continue;
                 for(const auto& v : ptr->GetVoxels())
-                    hQprojX.Fill(v.GetPosition().X(), v.GetCharge());
+                    fXProfile.Fill(v.GetPosition().X(), v.GetCharge());
             }
+            // Save in MergerData before it is analysed
+            if(fStoreProfiles)
+                fXProfile.FillTH1(fMergerData->fQprojX, "hQProjX", "All Q along X;X [pad];Q_{proj X}");
             // Compute x max from profile
-            auto xMax {GetRangeFromProfile(&hQprojX, false)}; // dont smooth
+            auto xMax {GetRangeFromProfile(fXProfile, false)}; // dont smooth
             fMergerData->fBSP = {(float)xMax, 0, 0};
-            // Save in MergerData
-            fMergerData->fQprojX = hQprojX;
         }
         return true;
     }
@@ -1310,30 +1477,23 @@ bool ActRoot::MergerDetector::ComputeXProfile()
         return true;
 }
 
-double ActRoot::MergerDetector::GetRangeFromProfile(TH1F* h, bool smooth)
+double ActRoot::MergerDetector::GetRangeFromProfile(Profile1D& profile, bool smooth)
 {
     // 1-> Smooth the histogram
     if(smooth)
-        h->Smooth();
+        profile.Smooth();
     // 2-> Find maximum
-    auto maxBin {h->GetMaximumBin()};
-    auto xMax {h->GetBinCenter(maxBin)};
-    auto yMax {h->GetBinContent(maxBin)};
+    auto maxBin {profile.GetMaximumBin()};
+    auto xMax {profile.GetBinCenter(maxBin)};
+    auto yMax {profile.GetBinContent(maxBin)};
     // 3-> Set reference point
     auto range {yMax / 5};
-    // 4-> Create interpolation functions
-    // Create TSpline
-    if(!h->GetEntries())
+    if(!profile.GetEntries())
         return 0;
-    auto spe {std::make_unique<TSpline3>(h, "b2,e2", 0, 0)};
-    // And now function
-    auto func {std::make_unique<TF1>(
-        "func", [&](double* x, double* p) { return spe->Eval(x[0]); }, h->GetXaxis()->GetXmin(),
-        h->GetXaxis()->GetXmax(), 1)};
-    // Find maximum in the range [xMax, xRangeMax of histogram]
+    // 4-> Find where the spline interpolation of the profile falls to range in [xMax, xRangeMax of histogram]
     double ret {};
     if(fEnableRootFind)
-        ret = func->GetX(range, xMax, h->GetXaxis()->GetXmax());
+        ret = profile.GetX(range, xMax, profile.GetXMax());
     return ret;
 }
 
@@ -1372,6 +1532,8 @@ void ActRoot::MergerDetector::Print() const
             std::cout << m << ", ";
         std::cout << '\n';
         std::cout << "-> InvertAngle   ? " << std::boolalpha << fInvertAngle << '\n';
+        std::cout << "-> PreSelection  ? " << std::boolalpha << fEnablePreSelection << '\n';
+        std::cout << "-> LeanOutput    ? " << std::boolalpha << fLeanOutput << '\n';
         std::cout << "-> EnableL1Val   ? " << std::boolalpha << fEnableL1Validation << '\n';
         if(fEnableL1Validation)
             std::cout << "-> L1Exclusion   : " << fL1ExclusionZone << '\n';
@@ -1411,5 +1573,7 @@ void ActRoot::MergerDetector::PrintReports() const
         std::cout << "Timer : " << fClockLabels[i] << '\n';
         fClocks[i].Print();
     }
+    if(fEnablePreSelection)
+        std::cout << "Pre-selection : " << fNPreSelected << " passed, " << fNPreRejected << " rejected" << '\n';
     std::cout << RESET << '\n';
 }
@@ -47,7 +47,8 @@ void ActRoot::ModularDetector::InitOutputData(std::shared_ptr<TTree> tree)
     if(fData)
         delete fData;
     fData = new ModularData;
-    tree->Branch("ModularData", &fData);
+    if(tree)
+        tree->Branch("ModularData", &fData);
     // Set to delete on destructor
     fDelData = true;
 }
@@ -63,17 +64,20 @@ void ActRoot::ModularDetector::BuildEventData(int run, int entry)
         // locate channel!
         int co {coas.globalchannelid >> 11};
         if(co == 31)
-        {
-            for(int hit = 0, size = coas.peakheight.size(); hit < size; hit++)
-            {
-                auto vxi {coas.peaktime[hit]};
-                auto leaf {fPars.GetName(vxi)};
-                if(leaf.length() == 0)
-                    continue;
-                // Write
-                fData->fLeaves[leaf] = coas.peakheight[hit];
-            }
-        }
+            ReadChannel(coas);
+    }
+}
+
+void ActRoot::ModularDetector::ReadChannel(ReducedData& coas)
+{
+    for(int hit = 0, size = coas.peakheight.size(); hit < size; hit++)
+    {
+        auto vxi {coas.peaktime[hit]};
+        auto leaf {fPars.GetName(vxi)};
+        if(leaf.length() == 0)
+            continue;
+        // Write
+        fData->fLeaves[leaf] = coas.peakheight[hit];
     }
 }
 
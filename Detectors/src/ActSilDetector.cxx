@@ -35,6 +35,8 @@ void ActRoot::SilDetector::ReadConfiguration(std::shared_ptr<InputBlock> config)
     auto file {config->GetString("Actions")};
     fPars.ReadActions(layers, legacy, file);
     // fPars.Print();
+    // Channel table must be rebuilt with the new VXI equivalences
+    fChannelsCalMan = nullptr;
 }
 
 void ActRoot::SilDetector::ReadCalibrations(std::shared_ptr<InputBlock> config)
@@ -69,7 +71,8 @@ void ActRoot::SilDetector::InitOutputData(std::shared_ptr<TTree> tree)
     if(fData)
         delete fData;
     fData = new SilData;
-    tree->Branch("SilData", &fData);
+    if(tree)
+        tree->Branch("SilData", &fData);
     // Set to delete on destructor
     fDelData = true;
 }
@@ -85,29 +88,53 @@ void ActRoot::SilDetector::BuildEventData(int run, int entry)
         // locate channel!
         int co {coas.globalchannelid >> 11};
         if(co == 31)
-        {
-            for(int hit = 0, size = coas.peakheight.size(); hit < size; hit++)
-            {
-                auto vxi {coas.peaktime[hit]};
-                auto [layer, sil] = fPars.GetSilIndex(vxi);
-                if(sil == -1)
-                    continue;
-                // Get raw data
-                float raw {coas.peakheight[hit]};
-                // Check threshold
-                std::string threshKey {"Sil_" + layer + "_" + sil + "_P"};
-                if(!fCalMan->ApplyThreshold(threshKey, raw, 3))
-                    continue;
-                // Write silicon number
-                fData->fSiN[layer].push_back(sil);
-                // Calibrate
-                std::string calKey {"Sil_" + layer + "_" + sil + "_E"};
-                float cal {static_cast<float>(fCalMan->ApplyCalibration(calKey, raw))};
-                fData->fSiE[layer].push_back(cal);
-                // std::cout<<"Raw sil = "<<raw<<" |"<<'\n';
-                // std::cout<<"Cal sil = "<<cal<<" |"<<'\n';
-            }
-        }
+            ReadChannel(coas);
+    }
+}
+
+void ActRoot::SilDetector::InitChannels()
+{
+    fChannels.clear();
+    fChannelsCalMan = fCalMan.get();
+    const auto& vxis {fPars.GetVXIMap()};
+    if(vxis.empty())
+        return;
+    fMinVXI = vxis.begin()->first;
+    fChannels.resize(vxis.rbegin()->first - fMinVXI + 1);
+    for(const auto& [vxi, pair] : vxis)
+    {
+        const auto& [layer, sil] {pair};
+        auto& channel {fChannels[vxi - fMinVXI]};
+        channel.fLayer = layer;
+        channel.fSil = sil;
+        channel.fThresh = fCalMan->GetHandle("Sil_" + layer + "_" + sil + "_P");
+        channel.fCal = fCalMan->GetHandle("Sil_" + layer + "_" + sil + "_E");
+    }
+}
+
+void ActRoot::SilDetector::ReadChannel(ReducedData& coas)
+{
+    // Keys are resolved once per CalibrationManager
+    if(fChannelsCalMan != fCalMan.get())
+        InitChannels();
+    for(int hit = 0, size = coas.peakheight.size(); hit < size; hit++)
+    {
+        int idx {static_cast<int>(coas.peaktime[hit]) - fMinVXI};
+        if(idx < 0 || idx >= fChannels.size() || fChannels[idx].fSil == -1)
+            continue;
+        const auto& channel {fChannels[idx]};
+        // Get raw data
+        float raw {coas.peakheight[hit]};
+        // Check threshold
+        if(!fCalMan->ApplyThreshold(channel.fThresh, raw, 3))
+            continue;
+        // Write silicon number
+        fData->fSiN[channel.fLayer].push_back(channel.fSil);
+        // Calibrate
+        float cal {static_cast<float>(fCalMan->ApplyCalibration(channel.fCal, raw))};
+        fData->fSiE[channel.fLayer].push_back(cal);
+        // std::cout<<"Raw sil = "<<raw<<" |"<<'\n';
+        // std::cout<<"Cal sil = "<<cal<<" |"<<'\n';
     }
 }
 
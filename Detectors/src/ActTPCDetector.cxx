@@ -64,16 +64,19 @@ void ActRoot::TPCDetector::ReadConfiguration(std::shared_ptr<InputBlock> config)
         fCleanDuplicatedVoxels = config->GetBool("CleanDuplicatedVoxels");
     if(config->CheckTokenExists("EnableRawBranchInFilter", true))
         fEnableRawBranchInFilter = config->GetBool("EnableRawBranchInFilter");
+    if(config->CheckTokenExists("RandomSeed", true))
+        fRand.SetSeed(config->GetInt("RandomSeed"));
 
     // Init of algorithms based on mode
     auto mode {ActRoot::Options::GetInstance()->GetMode()};
     // Cluster method
-    if(mode == ModeType::EReadTPC || mode == ModeType::EFilter || mode == ModeType::EFilterMerge ||
-       mode == ModeType::EGui)
+    if(mode == ModeType::EReadTPC || mode == ModeType::EReadAll || mode == ModeType::EFilter ||
+       mode == ModeType::EFilterMerge || mode == ModeType::EGui || mode == ModeType::ESimuReco)
         if(config->CheckTokenExists("ClusterMethod"))
             InitClusterMethod(config->GetString("ClusterMethod"));
     // Filter method
-    if(mode == ModeType::EFilter || mode == ModeType::EFilterMerge || mode == ModeType::EGui)
+    if(mode == ModeType::EFilter || mode == ModeType::EFilterMerge || mode == ModeType::EGui ||
+       mode == ModeType::ESimuReco)
         if(config->CheckTokenExists("FilterMethod"))
             InitFilterMethod(config->GetString("FilterMethod"));
 }
@@ -98,6 +101,7 @@ void ActRoot::TPCDetector::InitClusterMethod(const std::string& method)
         return;
     else
         throw std::runtime_error("TPCDetector::InitClusterMethod: no listed method from Ransac, Continuity and None");
+    fCluster->SetRandom(&fRand);
 }
 
 void ActRoot::TPCDetector::InitFilterMethod(const std::string& method)
@@ -148,7 +152,8 @@ void ActRoot::TPCDetector::InitOutputData(std::shared_ptr<TTree> tree)
     if(fData)
         delete fData;
     fData = new TPCData;
-    tree->Branch("TPCData", &fData);
+    if(tree)
+        tree->Branch("TPCData", &fData);
     // Set to delete in destructor
     fDelData = true;
 }
@@ -185,27 +190,42 @@ void ActRoot::TPCDetector::ClearEventFilter()
     fData->ClearFilter();
 }
 
+void ActRoot::TPCDetector::SetEvent(int run, int entry)
+{
+    fRand.SetEvent(run, entry);
+    if(fFilter)
+        fFilter->SetEvent(run, entry);
+}
+
 void ActRoot::TPCDetector::BuildEventData(int run, int entry)
 {
+    SetEvent(run, entry);
     for(auto& coas : fMEvent->CoboAsad)
+        ReadChannel(coas, coas.globalchannelid >> 11);
+    EndEventData();
+}
+
+void ActRoot::TPCDetector::ReadChannel(ReducedData& coas, int co)
+{
+    // locate channel!
+    int as {(coas.globalchannelid - (co << 11)) >> 9};
+    int ag {(coas.globalchannelid - (co << 11) - (as << 9)) >> 7};
+    int ch {(coas.globalchannelid - (co << 11) - (as << 9) - (ag << 7))};
+    int where {co * fPars.GetNBASAD() * fPars.GetNBAGET() * fPars.GetNBCHANNEL() +
+               as * fPars.GetNBAGET() * fPars.GetNBCHANNEL() + ag * fPars.GetNBCHANNEL() + ch};
+
+    // Read hits
+    if((co != 31) && (co != 16))
     {
-        // locate channel!
-        int co {coas.globalchannelid >> 11};
-        int as {(coas.globalchannelid - (co << 11)) >> 9};
-        int ag {(coas.globalchannelid - (co << 11) - (as << 9)) >> 7};
-        int ch {(coas.globalchannelid - (co << 11) - (as << 9) - (ag << 7))};
-        int where {co * fPars.GetNBASAD() * fPars.GetNBAGET() * fPars.GetNBCHANNEL() +
-                   as * fPars.GetNBAGET() * fPars.GetNBCHANNEL() + ag * fPars.GetNBCHANNEL() + ch};
-
-        // Read hits
-        if((co != 31) && (co != 16))
-        {
-            ReadHits(coas, where);
-        }
-        // If co == 31, optionally parse GATCONF
-        if((co == 31) && fModularPars)
-            ReadTrigger(coas);
+        ReadHits(coas, where);
     }
+    // If co == 31, optionally parse GATCONF
+    if((co == 31) && fModularPars)
+        ReadTrigger(coas);
+}
+
+void ActRoot::TPCDetector::EndEventData()
+{
     // Clean pad matrix from saturated tracks along Z
     if(fCleanPadMatrix)
         CleanPadMatrix();
@@ -359,7 +379,8 @@ void ActRoot::TPCDetector::BuildEventFilter()
 void ActRoot::TPCDetector::Print() const
 {
     std::cout << BOLDCYAN << "···· TPCDetector ····" << RESET << '\n';
-    if(ActRoot::Options::GetInstance()->GetMode() == ModeType::EReadTPC)
+    auto mode {ActRoot::Options::GetInstance()->GetMode()};
+    if(mode == ModeType::EReadTPC || mode == ModeType::EReadAll || mode == ModeType::ESimuReco)
     {
         std::cout << BOLDCYAN << "-> CleanSaturation         ? " << std::boolalpha << fCleanSaturatedMEvent << '\n';
         std::cout << "-> CleanPadMatrix          ? " << std::boolalpha << fCleanPadMatrix << '\n';
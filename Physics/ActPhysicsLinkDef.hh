@@ -7,6 +7,7 @@
 #pragma link C++ nestedclass;
 #pragma link C++ nestedtypedef;
 
+#pragma link C++ class ActPhysics::NuclideTable;
 #pragma link C++ class ActPhysics::Particle;
 #pragma link C++ class ActPhysics::Kinematics;
 #pragma link C++ class ActPhysics::SRIM;
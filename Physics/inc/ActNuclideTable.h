@@ -0,0 +1,59 @@
+#ifndef ActNuclideTable_h
+#define ActNuclideTable_h
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ActPhysics
+{
+//! Process-wide index of the NUBASE ground states
+/*!
+  The database is parsed only once, on first access, and indexed by (Z, A) and by name.
+  Instance creation is thread-safe, and lookups are read-only afterwards
+*/
+class NuclideTable
+{
+public:
+    //! Info stored per ground state
+    class Nuclide
+    {
+    public:
+        std::string fName {};
+        double fMassExcess {}; //!< Mass excess in MeV/c2
+        int fA {};
+        int fZ {};
+    };
+
+private:
+    // Singleton model
+    static std::shared_ptr<NuclideTable> fInstance;
+    static std::once_flag fOnce;
+
+    std::vector<Nuclide> fNuclides {};
+    std::unordered_map<int, int> fZAIndex {};
+    std::unordered_map<std::string, int> fNameIndex {};
+
+    NuclideTable(const std::string& file);
+
+public:
+    NuclideTable(const NuclideTable&) = delete;
+    void operator=(const NuclideTable&) = delete;
+
+    // Main method to get instance. File is only used in first call
+    static std::shared_ptr<NuclideTable> GetInstance(const std::string& file = "");
+
+    // Lookups: throw if not found
+    const Nuclide& Get(int Z, int A) const;
+    const Nuclide& Get(const std::string& name) const;
+    int GetSize() const { return fNuclides.size(); }
+
+private:
+    void ParseFile(const std::string& file);
+    int GetZAKey(int Z, int A) const { return Z * 1000 + A; }
+};
+} // namespace ActPhysics
+
+#endif
@@ -2,11 +2,12 @@
 #define ActParticle_h
 
 #include "ActConstants.h"
+#include "ActNuclideTable.h"
 
 #include <string>
 namespace ActPhysics
 {
-//! A class reading NUBASE particle info
+//! A class reading NUBASE particle info (through the shared NuclideTable)
 class Particle
 {
 private:
@@ -54,9 +55,7 @@ public:
     void Print() const;
 
 private:
-    void ParseFile(int Z, int A, const std::string& file = "");
-    void ParseFile(const std::string& particle, const std::string& file = "");
-    void Extract(const std::string& line);
+    void Extract(const NuclideTable::Nuclide& nuclide);
     std::string StripWhitespaces(std::string str);
     double GetSnX(unsigned int X) const;
     double GetSpX(unsigned int X) const;
@@ -4,6 +4,7 @@
 #include "TGraph.h"
 #include "TSpline.h"
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -32,6 +33,38 @@ public:
     using PtrSpline = std::shared_ptr<TSpline3>;
     using PtrGraph = std::shared_ptr<TGraph>;
 
+    //! Function sampled on a grid uniform in log(x) (or in x if the domain reaches 0)
+    /*!
+      Evaluation locates the cell in O(1) and interpolates linearly.
+      Outside the domain, first and last cells are extrapolated
+    */
+    class Table
+    {
+    private:
+        std::vector<double> fX {};
+        std::vector<double> fY {};
+        double fMin {};     //!< Lower edge of grid, in log(x) if fIsLog
+        double fInvStep {}; //!< Inverse of grid step
+        bool fIsLog {};
+
+    public:
+        Table() = default;
+        Table(const std::function<double(double)>& func, double min, double max, int size);
+
+        double Eval(double x) const;
+    };
+
+    //! Tables of a material, accessed by handle
+    class Tables
+    {
+    public:
+        Table fRange {};     //!< Energy -> Range
+        Table fEnergy {};    //!< Range -> Energy
+        Table fStopping {};  //!< Energy -> Stopping power
+        Table fLongStrag {}; //!< Range -> Longitudinal straggling
+        Table fLatStrag {};  //!< Range -> Lateral straggling
+    };
+
 private:
     std::vector<std::string> fKeys; //!< Store known tables
     // Energy->Range
@@ -51,6 +84,9 @@ private:
     std::map<std::string, PtrGraph> fGraphsLatStrag;
     // Bool to use spline or not
     bool fUseSpline {true}; //!< Use Spline interpolation by default. Can be disabled through set method
+    // Precomputed tables, indexed as fKeys
+    std::vector<Tables> fTables;
+    int fTableSize {5000}; //!< Number of nodes of each table
 
 
 public:
@@ -70,7 +106,9 @@ public:
     void SetStragglingLISE(const std::string& key, const std::string& fileName);
 
     // Set spline flag
-    void SetUseSpline(bool use = true) { fUseSpline = use; }
+    void SetUseSpline(bool use = true);
+    // Set number of nodes of precomputed tables
+    void SetTableSize(int size);
 
     // Main functions
     // Explicit names (easy to understand)
@@ -85,6 +123,27 @@ public:
     double EvalLongStraggling(const std::string& key, double range);
     double EvalLatStraggling(const std::string& key, double range);
 
+    // Precomputed tables: key resolved once to a handle. These functions are const and
+    // can be called concurrently from several threads
+    int GetHandle(const std::string& key) const;
+    const Tables& GetTables(int handle) const { return fTables.at(handle); }
+    double EvalRange(int handle, double energy) const { return fTables[handle].fRange.Eval(energy); }
+    double EvalEnergy(int handle, double range) const { return fTables[handle].fEnergy.Eval(range); }
+    double EvalStoppingPower(int handle, double energy) const { return fTables[handle].fStopping.Eval(energy); }
+    double EvalLongStraggling(int handle, double range) const { return fTables[handle].fLongStrag.Eval(range); }
+    double EvalLatStraggling(int handle, double range) const { return fTables[handle].fLatStrag.Eval(range); }
+    double Slow(int handle, double Tini, double thickness, double angleInRad = 0) const;
+    double SlowWithStraggling(int handle, double Tini, double thickness, double angleInRad = 0,
+                              TRandom* rand = nullptr) const;
+    double EvalInitialEnergy(int handle, double Tafter, double thickness, double angleInRad = 0) const;
+    double TravelledDistance(int handle, double Tini, double Tafter) const;
+    // Batch versions
+    std::vector<double> EvalRange(int handle, const std::vector<double>& energies) const;
+    std::vector<double> EvalEnergy(int handle, const std::vector<double>& ranges) const;
+    // Into a buffer that can be reused between calls, so no allocation is done once it is large enough
+    void EvalEnergy(int handle, const std::vector<double>& ranges, std::vector<double>& energies) const;
+    std::vector<double> Slow(int handle, const std::vector<double>& Tini, double thickness, double angleInRad = 0) const;
+
     // Drawing method
     void Draw(const std::vector<std::string>& keys = {});
 
@@ -114,6 +173,7 @@ private:
     PtrGraph GetGraph(std::vector<double>& x, std::vector<double>& y, const std::string& name);
     PtrSpline GetSpline(std::vector<double>& x, std::vector<double>& y, const std::string& name);
     double DoDeltaECalculation(const std::string& material, double init, double step, double deltaE, double dist);
+    void BuildTables(const std::string& key);
 };
 }; // namespace ActPhysics
 
@@ -0,0 +1,80 @@
+#include "ActNuclideTable.h"
+
+#include "TString.h"
+#include "TSystem.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+std::shared_ptr<ActPhysics::NuclideTable> ActPhysics::NuclideTable::fInstance = nullptr;
+std::once_flag ActPhysics::NuclideTable::fOnce {};
+
+ActPhysics::NuclideTable::NuclideTable(const std::string& file)
+{
+    ParseFile(file);
+}
+
+std::shared_ptr<ActPhysics::NuclideTable> ActPhysics::NuclideTable::GetInstance(const std::string& file)
+{
+    std::call_once(fOnce, [&]() { fInstance = std::shared_ptr<NuclideTable>(new NuclideTable(file)); });
+    return fInstance;
+}
+
+void ActPhysics::NuclideTable::ParseFile(const std::string& file)
+{
+    // If no file provided, use default
+    std::string filename {file};
+    if(filename.length() == 0)
+        filename = std::string(gSystem->Getenv("ACTROOT")) + "/Physics/Data/nubase20.txt";
+    // Streamer
+    std::ifstream streamer {filename};
+    if(!streamer)
+        throw std::runtime_error("NuclideTable(): Mass database file " + filename + " could not be opened");
+    // Parse
+    std::string line;
+    while(std::getline(streamer, line))
+    {
+        int i {std::stoi(line.substr(7, 1))}; // this measures whether it is an isomer or a normal ground state ( = 0)
+        if(i != 0)                            // we will work almost always with standard gs
+            continue;
+        Nuclide nuclide;
+        // 1->Name
+        nuclide.fName = line.substr(11, 5);
+        nuclide.fName.erase(std::remove_if(nuclide.fName.begin(), nuclide.fName.end(),
+                                           [](char x) { return std::isspace(x); }),
+                            nuclide.fName.end());
+        // 2->A
+        nuclide.fA = std::stoi(line.substr(0, 3));
+        // 3->Z
+        nuclide.fZ = std::stoi(line.substr(4, 3));
+        // 4-> Mass excess
+        nuclide.fMassExcess = std::stod(line.substr(18, 13)) * 1.e-3; // keV to MeV
+        // Index: keep first occurrence, as a linear search would do
+        int idx {static_cast<int>(fNuclides.size())};
+        if(!fZAIndex.emplace(GetZAKey(nuclide.fZ, nuclide.fA), idx).second)
+            continue;
+        fNameIndex.emplace(nuclide.fName, idx);
+        fNuclides.push_back(std::move(nuclide));
+    }
+}
+
+const ActPhysics::NuclideTable::Nuclide& ActPhysics::NuclideTable::Get(int Z, int A) const
+{
+    auto it {fZAIndex.find(GetZAKey(Z, A))};
+    if(it == fZAIndex.end())
+        throw std::runtime_error(TString::Format("No found particle with Z: %d and A: %d", Z, A));
+    return fNuclides[it->second];
+}
+
+const ActPhysics::NuclideTable::Nuclide& ActPhysics::NuclideTable::Get(const std::string& name) const
+{
+    auto it {fNameIndex.find(name)};
+    if(it == fNameIndex.end())
+        throw std::runtime_error(TString::Format("No found particle with name: %s", name.c_str()));
+    return fNuclides[it->second];
+}
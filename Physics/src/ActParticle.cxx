@@ -1,57 +1,19 @@
 #include "ActParticle.h"
 
 #include "ActConstants.h"
-
-#include "TString.h"
-#include "TSystem.h"
+#include "ActNuclideTable.h"
 
 #include <algorithm>
 #include <cctype>
-#include <fstream>
 #include <iostream>
-#include <stdexcept>
 #include <string>
 
 ActPhysics::Particle::Particle(int Z, int A)
 {
-    ParseFile(Z, A);
+    Extract(NuclideTable::GetInstance()->Get(Z, A));
 }
 
 ActPhysics::Particle::Particle(const std::string& particle)
-{
-    ParseFile(particle);
-}
-
-void ActPhysics::Particle::ParseFile(int Z, int A, const std::string& file)
-{
-    // If no file provided, use default
-    std::string filename {file};
-    if(filename.length() == 0)
-        filename = std::string(gSystem->Getenv("ACTROOT")) + "/Physics/Data/nubase20.txt";
-    // Streamer
-    std::ifstream streamer {filename};
-    if(!streamer)
-        throw std::runtime_error("Particle(): Mass database file " + filename + " could not be opened");
-    // Parse
-    std::string line, zstr, astr, istr;
-    while(std::getline(streamer, line))
-    {
-        astr = line.substr(0, 3);
-        zstr = line.substr(4, 3);
-        istr = line.substr(7, 1);
-        int a {std::stoi(astr)};
-        int z {std::stoi(zstr)};
-        int i {std::stoi(istr)};       // this measures whether it is an isomer or a normal ground state ( = 0)
-        if(a == A && z == Z && i == 0) // we will work almost always with standard gs
-        {
-            Extract(line);
-            return;
-        }
-    }
-    throw std::runtime_error(TString::Format("No found particle with Z: %d and A: %d", Z, A));
-}
-
-void ActPhysics::Particle::ParseFile(const std::string& particle, const std::string& file)
 {
     auto isotope {StripWhitespaces(particle)};
     // Convert legacy names to table ones
@@ -67,49 +29,16 @@ void ActPhysics::Particle::ParseFile(const std::string& particle, const std::str
         isotope = "1n";
     else
         ;
-    // If no file provided, use default
-    std::string filename {file};
-    if(filename.length() == 0)
-        filename = std::string(gSystem->Getenv("ACTROOT")) + "/Physics/Data/nubase20.txt";
-    // Streamer
-    std::ifstream streamer {filename};
-    if(!streamer)
-        throw std::runtime_error("Particle(): Mass database file " + filename + " could not be opened");
-    // Parse
-    std::string line, name, istr;
-    while(std::getline(streamer, line))
-    {
-        istr = line.substr(7, 1);
-        name = line.substr(11, 5);
-        name = StripWhitespaces(name);
-        int i {std::stoi(istr)};      // this measures whether it is an isomer or a normal ground state ( = 0)
-        if(name == isotope && i == 0) // we will work almost always with standard gs
-        {
-            Extract(line);
-            return;
-        }
-    }
-    throw std::runtime_error(TString::Format("No found particle with name: %s", particle.c_str()));
+    Extract(NuclideTable::GetInstance()->Get(isotope));
 }
 
-void ActPhysics::Particle::Extract(const std::string& line)
+void ActPhysics::Particle::Extract(const NuclideTable::Nuclide& nuclide)
 {
-    // Get important info
-    // 1->Name
-    auto name {line.substr(11, 5)};
-    // Strip whitespaces if needed
-    name.erase(std::remove_if(name.begin(), name.end(), [](char x) { return std::isspace(x); }), name.end());
-    fName = name;
-    // 2->A
-    auto astr {line.substr(0, 3)};
-    fA = std::stoi(astr);
-    // 3->Z
-    auto zstr {line.substr(4, 3)};
-    fZ = std::stoi(zstr);
-    // 4-> Mass excess
-    auto massexcess {line.substr(18, 13)};
-    fMassExcess = std::stod(massexcess) * 1.e-3; // keV to MeV
-    // Build mass of gs at the moment of reading the database file
+    fName = nuclide.fName;
+    fA = nuclide.fA;
+    fZ = nuclide.fZ;
+    fMassExcess = nuclide.fMassExcess;
+    // Build mass of gs at the moment of reading the database
     fMass = fA * Constants::kamuToMeVC2 + fMassExcess - fZ * Constants::keMass;
     fGSMass = fMass;
 }
@@ -11,8 +11,10 @@
 #include "TString.h"
 
 #include <algorithm>
+#include <cmath>
 #include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -172,8 +174,8 @@ void ActPhysics::SRIM::ReadSRIM(const std::string& key, const std::string& file)
     fGraphsLatStrag[key] = GetGraph(vR, vLatStrag, "RtoLatS");
     fGraphsLatStrag[key]->SetTitle(";Range [mm];Lateral stragging [mm]");
 
-    // and finally store keys
-    fKeys.push_back(key);
+    // and finally store keys and precompute tables
+    BuildTables(key);
 }
 
 void ActPhysics::SRIM::ReadGeant4(const std::string& key, const std::string& file)
@@ -226,8 +228,8 @@ void ActPhysics::SRIM::ReadGeant4(const std::string& key, const std::string& fil
     fGraphsLatStrag[key] = GetGraph(vR, vLatStrag, "RtoLatS");
     fGraphsLatStrag[key]->SetTitle(";Range [mm];Lateral stragging [mm]");
 
-    // and finally store keys
-    fKeys.push_back(key);
+    // and finally store keys and precompute tables
+    BuildTables(key);
 }
 
 void ActPhysics::SRIM::ReadTable(const std::string& key, const std::string& file, bool isSRIM)
@@ -277,6 +279,171 @@ void ActPhysics::SRIM::SetStragglingLISE(const std::string& key, const std::stri
     fSplinesLongStrag[key] = GetSpline(vR, vLongStrag, "RtoLongS");
     fGraphsLongStrag[key] = GetGraph(vR, vLongStrag, "RtoLongS");
     fGraphsLongStrag[key]->SetTitle(";Range [mm];Longitudinal straggling [mm]");
+    // Tables of stored key must be updated
+    if(CheckKeyIsStored(key))
+        BuildTables(key);
+}
+
+ActPhysics::SRIM::Table::Table(const std::function<double(double)>& func, double min, double max, int size)
+{
+    if(size < 2 || !(min < max))
+        throw std::invalid_argument("SRIM::Table: needs at least 2 nodes and min < max");
+    // Tables span several orders of magnitude: sample uniformly in log(x) when possible
+    fIsLog = min > 0;
+    fMin = fIsLog ? std::log(min) : min;
+    double step {((fIsLog ? std::log(max) : max) - fMin) / (size - 1)};
+    fInvStep = 1. / step;
+    fX.resize(size);
+    fY.resize(size);
+    for(int i = 0; i < size; i++)
+    {
+        auto u {fMin + i * step};
+        fX[i] = fIsLog ? std::exp(u) : u;
+        fY[i] = func(fX[i]);
+    }
+}
+
+double ActPhysics::SRIM::Table::Eval(double x) const
+{
+    int last {static_cast<int>(fX.size()) - 2};
+    int i {};
+    if(x <= fX.front())
+        i = 0;
+    else if(x >= fX.back())
+        i = last;
+    else
+        i = std::min(last, static_cast<int>(((fIsLog ? std::log(x) : x) - fMin) * fInvStep));
+    auto t {(x - fX[i]) / (fX[i + 1] - fX[i])};
+    return fY[i] + t * (fY[i + 1] - fY[i]);
+}
+
+void ActPhysics::SRIM::BuildTables(const std::string& key)
+{
+    auto it {std::find(fKeys.begin(), fKeys.end(), key)};
+    if(it == fKeys.end())
+    {
+        fKeys.push_back(key);
+        fTables.push_back({});
+        it = fKeys.end() - 1;
+    }
+    auto& tables {fTables[it - fKeys.begin()]};
+    // Sampled with the string-keyed functions, so the same interpolation (spline or not) is used
+    auto build = [&](const PtrGraph& g, std::function<double(double)> func)
+    {
+        auto n {g->GetN()};
+        auto* x {g->GetX()};
+        return Table {func, *std::min_element(x, x + n), *std::max_element(x, x + n), fTableSize};
+    };
+    tables.fRange = build(fGraphsDirect[key], [&](double e) { return EvalDirect(key, e); });
+    tables.fEnergy = build(fGraphsInverse[key], [&](double r) { return EvalInverse(key, r); });
+    tables.fStopping = build(fGraphsStoppings[key], [&](double e) { return EvalStoppingPower(key, e); });
+    tables.fLongStrag = build(fGraphsLongStrag[key], [&](double r) { return EvalLongStraggling(key, r); });
+    tables.fLatStrag = build(fGraphsLatStrag[key], [&](double r) { return EvalLatStraggling(key, r); });
+}
+
+void ActPhysics::SRIM::SetUseSpline(bool use)
+{
+    fUseSpline = use;
+    for(const auto& key : fKeys)
+        BuildTables(key);
+}
+
+void ActPhysics::SRIM::SetTableSize(int size)
+{
+    fTableSize = size;
+    for(const auto& key : fKeys)
+        BuildTables(key);
+}
+
+int ActPhysics::SRIM::GetHandle(const std::string& key) const
+{
+    auto it {std::find(fKeys.begin(), fKeys.end(), key)};
+    if(it == fKeys.end())
+        throw std::runtime_error("SRIM::GetHandle(): key " + key + " is not stored");
+    return it - fKeys.begin();
+}
+
+double ActPhysics::SRIM::Slow(int handle, double Tini, double thickness, double angleInRad) const
+{
+    auto RIni {EvalRange(handle, Tini)};
+    auto dist {thickness / TMath::Cos(angleInRad)};
+    auto RAfter {RIni - dist};
+    if(RAfter <= 0)
+        return 0;
+    auto ret {EvalEnergy(handle, RAfter)};
+    if(ret > Tini)
+        return Tini;
+    return ret;
+}
+
+double ActPhysics::SRIM::SlowWithStraggling(int handle, double Tini, double thickness, double angleInRad,
+                                            TRandom* rand) const
+{
+    double dist {thickness / TMath::Cos(angleInRad)};
+    auto RIni {EvalRange(handle, Tini)};
+    auto uRini {EvalLongStraggling(handle, RIni)};
+    auto RAfter {RIni - dist};
+    if(RAfter <= 0)
+        return 0;
+    auto uRAfter {EvalLongStraggling(handle, RAfter)};
+    auto udist {TMath::Sqrt(uRini * uRini - uRAfter * uRAfter)};
+    dist = (rand ? rand : gRandom)->Gaus(dist, udist);
+    RAfter = RIni - dist;
+    if(RAfter <= 0)
+        return 0;
+    auto ret {EvalEnergy(handle, RAfter)};
+    if(ret > Tini)
+        return Tini;
+    return ret;
+}
+
+double ActPhysics::SRIM::EvalInitialEnergy(int handle, double Tafter, double thickness, double angleInRad) const
+{
+    auto RIni {EvalRange(handle, Tafter) + thickness / TMath::Cos(angleInRad)};
+    return EvalEnergy(handle, RIni);
+}
+
+double ActPhysics::SRIM::TravelledDistance(int handle, double Tini, double Tafter) const
+{
+    return EvalRange(handle, Tini) - EvalRange(handle, Tafter);
+}
+
+std::vector<double> ActPhysics::SRIM::EvalRange(int handle, const std::vector<double>& energies) const
+{
+    const auto& table {fTables[handle].fRange};
+    std::vector<double> ret(energies.size());
+    for(int i = 0, size = energies.size(); i < size; i++)
+        ret[i] = table.Eval(energies[i]);
+    return ret;
+}
+
+std::vector<double> ActPhysics::SRIM::EvalEnergy(int handle, const std::vector<double>& ranges) const
+{
+    std::vector<double> ret;
+    EvalEnergy(handle, ranges, ret);
+    return ret;
+}
+
+void ActPhysics::SRIM::EvalEnergy(int handle, const std::vector<double>& ranges, std::vector<double>& energies) const
+{
+    const auto& table {fTables[handle].fEnergy};
+    energies.resize(ranges.size());
+    for(int i = 0, size = ranges.size(); i < size; i++)
+        energies[i] = table.Eval(ranges[i]);
+}
+
+std::vector<double>
+ActPhysics::SRIM::Slow(int handle, const std::vector<double>& Tini, double thickness, double angleInRad) const
+{
+    auto dist {thickness / TMath::Cos(angleInRad)};
+    const auto& tables {fTables[handle]};
+    std::vector<double> ret(Tini.size());
+    for(int i = 0, size = Tini.size(); i < size; i++)
+    {
+        auto RAfter {tables.fRange.Eval(Tini[i]) - dist};
+        ret[i] = (RAfter <= 0) ? 0 : std::min(Tini[i], tables.fEnergy.Eval(RAfter));
+    }
+    return ret;
 }
 
 // All eval functions
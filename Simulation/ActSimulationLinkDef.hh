@@ -28,6 +28,8 @@
 
 // Cross section sampler
 #pragma link C++ class ActSim::CrossSection;
+#pragma link C++ class ActSim::AliasTable;
+#pragma link C++ class ActSim::AliasTable2D;
 
 
 #endif
@@ -0,0 +1,74 @@
+#ifndef ActAliasTable_h
+#define ActAliasTable_h
+
+#include "TRandom.h"
+
+#include <utility>
+#include <vector>
+
+namespace ActSim
+{
+//! Constant-time sampler of a tabulated distribution
+/*!
+  The density is linearly interpolated between the nodes (x, y). A segment is chosen
+  with Walker's alias method and x inside it by inverting the CDF of the linear density,
+  so each draw takes O(1) whatever the number of nodes.
+  Sampling is const and only uses the generator passed to it: a table can be shared
+  by several threads, each one with its own TRandom
+*/
+class AliasTable
+{
+private:
+    std::vector<double> fX {};
+    std::vector<double> fY {};
+    std::vector<double> fProb {}; //!< Probability to keep each segment instead of its alias
+    std::vector<int> fAlias {};
+    double fIntegral {};
+
+public:
+    AliasTable() = default;
+    AliasTable(const std::vector<double>& x, const std::vector<double>& y) { Init(x, y); }
+
+    //! Build from increasing x nodes and non-negative density y. Negative values are set to 0
+    void Init(const std::vector<double>& x, const std::vector<double>& y);
+
+    // Sample from two uniform numbers in [0, 1)
+    double Sample(double r1, double r2) const;
+    double Sample(TRandom* rand = nullptr) const;
+
+    // Getters
+    bool IsEmpty() const { return fProb.empty(); }
+    double GetIntegral() const { return fIntegral; }
+    double GetXMin() const { return fX.front(); }
+    double GetXMax() const { return fX.back(); }
+};
+
+//! Sampler of a distribution that depends on a parameter, such as the beam energy
+/*!
+  Holds an AliasTable at each node of the parameter. In between, the table of the lower
+  or the upper node is used with probability given by the linear interpolation weight,
+  so sampling is O(1) in the number of x nodes and O(log n) in the parameter ones
+*/
+class AliasTable2D
+{
+private:
+    std::vector<double> fPars {};
+    std::vector<AliasTable> fTables {};
+
+public:
+    AliasTable2D() = default;
+
+    //! Tables must be added in increasing order of parameter
+    void AddTable(double par, const AliasTable& table);
+    void Clear();
+
+    double Sample(double par, TRandom* rand = nullptr) const;
+
+    // Getters
+    bool IsEmpty() const { return fTables.empty(); }
+    double GetParMin() const { return fPars.front(); }
+    double GetParMax() const { return fPars.back(); }
+};
+} // namespace ActSim
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef ActCrossSection_h
 #define ActCrossSection_h
 
+#include "ActAliasTable.h"
+
 #include "TH1.h"
 #include "TSpline.h"
 
@@ -14,9 +16,11 @@ class CrossSection
 private:
     std::vector<double> fX {};
     std::vector<double> fY {};
-    TSpline3* fCDF {};       //!< For CDF sampling
-    TH1D* fHist {};          //!< For direct count sampling
-    TGraph* fTheoXSGraph {}; //!< Theoretical input graph
+    TSpline3* fCDF {};          //!< For CDF sampling
+    TH1D* fHist {};             //!< For direct count sampling
+    TGraph* fTheoXSGraph {};    //!< Theoretical input graph
+    AliasTable fAlias {};       //!< For constant-time sampling of the linearly interpolated xs
+    std::string fAliasError {}; //!< Why fAlias could not be built from the input, if so
     double fStep {};
     double fTotalXS {};
     bool fIsAngle {};
@@ -32,14 +36,18 @@ public:
 
     // Sampling methods
     double SampleCDF(double r);
-    double SampleCDF();
+    double SampleCDF(TRandom* rand = nullptr);
     double SampleHist(TRandom* rand = nullptr);
+    //! O(1) and thread-safe if each thread passes its own generator. Throws if the alias table could not be built
+    double Sample(TRandom* rand = nullptr) const;
 
     // Getters
     double GetTotalXSmbarn() { return fTotalXS; }
     double GetTotalXScm2() const { return fTotalXS * 1e-27; }
     double GetIntervalXS(double minAngle, double maxAngle);
     TGraph* GetTheoXSGraph() const { return fTheoXSGraph; }
+    //! To build an AliasTable2D from the xs at several beam energies. Empty if input is not valid for it
+    const AliasTable& GetAliasTable() const { return fAlias; }
 
     // Others
     void Draw() const;
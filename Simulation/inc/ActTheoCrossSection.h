@@ -1,5 +1,7 @@
 #ifndef ActTheoCrossSection_h
 #define ActTheoCrossSection_h
+#include "ActAliasTable.h"
+
 #include "TCanvas.h"
 #include "TF1.h"
 #include "TLegend.h"
@@ -47,6 +49,10 @@ namespace ActSim
         std::vector<double> legendreCoeffs {};
         std::function<double(double*, double*)> lambda {};
         std::unique_ptr<TF1> xsAtEnergy {};
+        //samplers of cos(theta): at the set energy and tabulated in energy
+        int nCosNodes {1001};
+        ActSim::AliasTable cosTable {};
+        ActSim::AliasTable2D cosTable2D {};
 
         //for canvas
         std::unique_ptr<TCanvas> canvScattering {};
@@ -70,10 +76,19 @@ namespace ActSim
         void ReadScatteringCrossSection(std::string fileName);
         void ReadAngularCrossSection(std::string fileName);
 
+        void SetNCosNodes(int n){ nCosNodes = n; }
+        int GetNCosNodes() const { return nCosNodes; }
+
         void ComputeXSAtEnergy(double Tn);
         double EvalScatteringXS(double Tn);
         double IntegrateTotalXS(double low = -1.0, double high = 1.0);
-        double SampleXS(TRandom3* generator = nullptr);
+        //sample theta (rad) at energy set in ComputeXSAtEnergy
+        double SampleXS(TRandom* generator = nullptr);
+
+        //tabulate angular xs at nEnergies in [Tmin, Tmax] to sample at any energy
+        void BuildEnergyTable(double Tmin, double Tmax, int nEnergies);
+        //sample theta (rad) at energy Tn, interpolating in energy table. Can be called from several threads
+        double SampleXS(double Tn, TRandom* generator = nullptr) const;
 
         void DrawScattering();
         void DrawAngular();
@@ -84,6 +99,8 @@ namespace ActSim
 
     private:
         void ParseLine(std::string& line, std::vector<double>& coeffs);
+        void ComputeLegendreCoeffs(double Tn, std::vector<double>& coeffs) const;
+        ActSim::AliasTable BuildCosTable(const std::vector<double>& coeffs) const;
     };
 
 }
@@ -11,7 +11,6 @@
 #include "Math/Point3D.h"
 #include "Math/Vector3D.h"
 
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -57,6 +56,7 @@ private:
 
     // General parameters of simulator
     double fRangeStep {0.75}; // mm
+    bool fCumulativeRange {}; //!< Energy at each step from the residual range instead of SRIM::Slow
     // Sampling frequency
     double fSamplingFreq {12.5};
     // Time start of trigger
@@ -64,8 +64,16 @@ private:
 
     // Vectors of simulated points
     std::vector<std::vector<ActRoot::Voxel>> fCloud;
-    // Vector to convert
-    std::map<std::pair<int, int>, std::vector<std::pair<int, double>>> fData;
+    // Signals per pad (index padx * NPADSY + pady) as pairs of [time bucket, charge]
+    std::vector<std::vector<std::pair<int, double>>> fData;
+    std::vector<int> fPadsWithData; //!< Indexes of fData with signal, so only those are reset
+    // Diffusion kernel along X and Y of current charge step
+    std::vector<double> fKernelX;
+    std::vector<double> fKernelY;
+    // Buffers of cumulative range stepping
+    std::vector<double> fStepR;
+    std::vector<double> fStepRes;
+    std::vector<double> fStepE;
     // Vertex
     XYZPoint fVertex {-1, -1, -1};
     // TPCData in Thomas version
@@ -85,6 +93,8 @@ public:
     void SetCalibrations(ActRoot::CalibrationManager* cals) { fCalMan = cals; }
     // Getters
     const XYZPoint& GetVertex() const { return fVertex; }
+    //! Simulated event, filled by Convert. Address is kept between events
+    MEventReduced* GetMEvent() { return &fMEvent; }
 
     // Generate a vertex
     void GenVertex();
@@ -105,10 +115,13 @@ public:
 
 private:
     bool IsInChamber(const XYZPoint& p);
+    //! Deposit the energy lost in each step of fRangeStep along dir. Returns the energy left after the last one
     double FillCloud(const std::string& which, double T, double l, const XYZPoint& point, const XYZVector& dir);
+    //! Same as FillCloud, with energies from the residual range. SRIM is evaluated once per track for all its steps
+    double FillCloudCumulative(int handle, double T, double l, const XYZPoint& point, const XYZVector& dir);
     template <typename T>
     std::pair<int, int> GetPadRange(const T& p, const std::string& which);
-    double SpreadCharge(const XYZPoint& p, double x, double y);
+    void FillKernel(double pos, int minPad, int maxPad, std::vector<double>& kernel);
     void FillMEvent();
 };
 } // namespace ActSim
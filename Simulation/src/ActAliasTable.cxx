@@ -0,0 +1,116 @@
+#include "ActAliasTable.h"
+
+#include "TRandom.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+void ActSim::AliasTable::Init(const std::vector<double>& x, const std::vector<double>& y)
+{
+    if(x.size() != y.size() || x.size() < 2)
+        throw std::invalid_argument("AliasTable::Init(): x and y must have the same size, at least 2");
+    fX = x;
+    fY = y;
+    for(auto& val : fY)
+        val = std::max(val, 0.);
+    // Weight of each segment: integral of the linear density
+    int n {static_cast<int>(fX.size()) - 1};
+    std::vector<double> weights(n);
+    fIntegral = 0;
+    for(int i = 0; i < n; i++)
+    {
+        if(fX[i + 1] <= fX[i])
+            throw std::invalid_argument("AliasTable::Init(): x must be strictly increasing");
+        weights[i] = 0.5 * (fY[i] + fY[i + 1]) * (fX[i + 1] - fX[i]);
+        fIntegral += weights[i];
+    }
+    if(!(fIntegral > 0))
+        throw std::invalid_argument("AliasTable::Init(): density has null integral");
+    // Vose's construction of the alias table, with weights scaled to a mean of 1
+    fProb.assign(n, 1);
+    fAlias.resize(n);
+    std::vector<int> small;
+    std::vector<int> large;
+    for(int i = 0; i < n; i++)
+    {
+        weights[i] *= n / fIntegral;
+        fAlias[i] = i;
+        (weights[i] < 1 ? small : large).push_back(i);
+    }
+    while(!small.empty() && !large.empty())
+    {
+        auto s {small.back()};
+        small.pop_back();
+        auto l {large.back()};
+        fProb[s] = weights[s];
+        fAlias[s] = l;
+        // The large one gives away what s lacks
+        weights[l] -= 1 - weights[s];
+        if(weights[l] < 1)
+        {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // Remaining ones are 1 up to rounding. Keep them unless they are empty
+    for(auto i : small)
+        fProb[i] = (weights[i] > 0) ? 1 : 0;
+}
+
+double ActSim::AliasTable::Sample(double r1, double r2) const
+{
+    // 1-> Segment: column from integer part, coin from fractional one
+    int n {static_cast<int>(fProb.size())};
+    double u {r1 * n};
+    int i {std::min(static_cast<int>(u), n - 1)};
+    int seg {(u - i < fProb[i]) ? i : fAlias[i]};
+    // 2-> Inside segment, solving y0 t + (y1 - y0) t^2 / 2 = r2 (y0 + y1) / 2 for t in [0, 1]
+    // in a form that is stable when y0 ~ y1
+    double y0 {fY[seg]};
+    double y1 {fY[seg + 1]};
+    double den {y0 + std::sqrt(y0 * y0 + r2 * (y1 * y1 - y0 * y0))};
+    double t {(den > 0) ? r2 * (y0 + y1) / den : r2};
+    return fX[seg] + t * (fX[seg + 1] - fX[seg]);
+}
+
+double ActSim::AliasTable::Sample(TRandom* rand) const
+{
+    if(!rand)
+        rand = gRandom;
+    auto r1 {rand->Uniform()};
+    auto r2 {rand->Uniform()};
+    return Sample(r1, r2);
+}
+
+void ActSim::AliasTable2D::AddTable(double par, const AliasTable& table)
+{
+    if(!fPars.empty() && par <= fPars.back())
+        throw std::invalid_argument("AliasTable2D::AddTable(): parameters must be added in increasing order");
+    fPars.push_back(par);
+    fTables.push_back(table);
+}
+
+void ActSim::AliasTable2D::Clear()
+{
+    fPars.clear();
+    fTables.clear();
+}
+
+double ActSim::AliasTable2D::Sample(double par, TRandom* rand) const
+{
+    if(fTables.empty())
+        throw std::runtime_error("AliasTable2D::Sample(): no tables added");
+    if(!rand)
+        rand = gRandom;
+    // Outside the range, the closest table is used
+    auto it {std::upper_bound(fPars.begin(), fPars.end(), par)};
+    if(it == fPars.begin())
+        return fTables.front().Sample(rand);
+    if(it == fPars.end())
+        return fTables.back().Sample(rand);
+    int up {static_cast<int>(it - fPars.begin())};
+    double w {(par - fPars[up - 1]) / (fPars[up] - fPars[up - 1])};
+    return fTables[(rand->Uniform() < w) ? up : up - 1].Sample(rand);
+}
@@ -17,6 +17,7 @@
 #include <iostream>
 #include <numeric>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -45,18 +46,23 @@ void ActSim::CrossSection::Init(int n, const double* x, const double* y)
         fTotalXS = std::accumulate(fY.begin(), fY.end(), 0.0);
 
     // Compute the CDF
-    double sumXS {};
-    for(const auto& xs : fY)
-        sumXS += xs;
-    // Now the CDF
-    std::vector<double> CDFData {};
-    for(int i = 0; i < fX.size(); i++)
-    {
-        double termCDF {};
-        for(int j = 0; j <= i; j++)
-            termCDF += fY[j];
+    std::vector<double> CDFData(fY.size());
+    std::partial_sum(fY.begin(), fY.end(), CDFData.begin());
+    auto sumXS {CDFData.back()};
+    for(auto& termCDF : CDFData)
         termCDF /= sumXS;
-        CDFData.push_back(termCDF);
+
+    // Alias table on the same points. Input accepted by the other samplers (repeated x, null xs...)
+    // may not be valid for it: then it is left empty and Sample() reports the reason
+    fAliasError.clear();
+    try
+    {
+        fAlias.Init(fX, fY);
+    }
+    catch(const std::invalid_argument& e)
+    {
+        fAlias = AliasTable {};
+        fAliasError = e.what();
     }
 
     // Get the Spline
@@ -178,12 +184,20 @@ double ActSim::CrossSection::SampleCDF(double r)
     return fCDF->Eval(r);
 }
 
-double ActSim::CrossSection::SampleCDF()
+double ActSim::CrossSection::SampleCDF(TRandom* rand)
 {
-    return SampleCDF(gRandom->Uniform());
+    return SampleCDF((rand ? rand : gRandom)->Uniform());
 }
 
 double ActSim::CrossSection::SampleHist(TRandom* rand)
 {
     return fHist->GetRandom(rand);
 }
+
+double ActSim::CrossSection::Sample(TRandom* rand) const
+{
+    if(fAlias.IsEmpty())
+        throw std::runtime_error("CrossSection::Sample(): no alias table, " +
+                                 (fAliasError.empty() ? std::string {"cross section not read yet"} : fAliasError));
+    return fAlias.Sample(rand);
+}
@@ -60,7 +60,7 @@ std::pair<double, double> ActSim::Runner::EnergyAfterSilicons(double T3EnteringS
     {
         double RLeftWithStraggling {};
         if(enableStraggling)
-            RLeftWithStraggling = fsrim->SlowWithStraggling(silString, T3EnteringSil, silWidth);
+            RLeftWithStraggling = fsrim->SlowWithStraggling(silString, T3EnteringSil, silWidth, 0, fRand);
         else
             RLeftWithStraggling = RLeft; // no straggling
 
@@ -103,7 +103,7 @@ double ActSim::Runner::EnergyAfterGas(double TIni, double distance, const std::s
     else
     {
         // auto RLeftWithStraggling {ApplyStragglingInMaterialToRLeft(RIni, RLeft, gasKey)};
-        return fsrim->SlowWithStraggling(gasKey, TIni, distance);
+        return fsrim->SlowWithStraggling(gasKey, TIni, distance, 0, fRand);
     }
 }
 
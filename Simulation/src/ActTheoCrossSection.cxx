@@ -1,5 +1,7 @@
 #include "ActTheoCrossSection.h"
 
+#include "ActAliasTable.h"
+
 #include "Rtypes.h"
 #include "TCanvas.h"
 #include "TPad.h"
@@ -245,21 +247,39 @@ void ActSim::TheoCrossSection::DrawAngular()
     //canvAngular->Close();
 }
 
-void ActSim::TheoCrossSection::ComputeXSAtEnergy(double Tn)
+void ActSim::TheoCrossSection::ComputeLegendreCoeffs(double Tn, std::vector<double>& coeffs) const
 {
-    scatteringXS = functScattering->Eval(Tn);
-    legendreCoeffs.clear();
-    legendreCoeffs.push_back(1.0); //a_0 = 1.0 always according to documentation
+    coeffs.clear();
+    coeffs.push_back(1.0); //a_0 = 1.0 always according to documentation
     for(auto& leg : mAngular)
     {
         //ensure that this coeff contributes at this energy
         double minT { leg.second.first.front()};
         double maxT { leg.second.first.back()};
-        //std::cout<<"minT: "<<minT<<" maxT: "<<maxT<<'\n';
         bool isInInterval { (Tn >= minT) && (Tn <= maxT)};
-        legendreCoeffs.push_back((isInInterval) ? funcsAngular[leg.first]->Eval(Tn) : 0.0);
-        //std::cout<<"Legendre coeff "<<leg.first<<" : "<<legendreCoeffs.back()<<'\n';
+        coeffs.push_back((isInInterval) ? splinesAngular.at(leg.first)->Eval(Tn) : 0.0);
     }
+}
+
+ActSim::AliasTable ActSim::TheoCrossSection::BuildCosTable(const std::vector<double>& coeffs) const
+{
+    //angular distribution on a uniform grid of cos(theta). Normalization is irrelevant for sampling
+    std::vector<double> x(nCosNodes);
+    std::vector<double> y(nCosNodes);
+    for(int i = 0; i < nCosNodes; i++)
+    {
+        x[i] = -1.0 + 2.0 * i / (nCosNodes - 1);
+        for(int l = 0; l < coeffs.size(); l++)
+            y[i] += (2.0 * l + 1) / 2 * coeffs[l] * ROOT::Math::legendre(l, x[i]);
+    }
+    return {x, y};
+}
+
+void ActSim::TheoCrossSection::ComputeXSAtEnergy(double Tn)
+{
+    scatteringXS = functScattering->Eval(Tn);
+    ComputeLegendreCoeffs(Tn, legendreCoeffs);
+    cosTable = BuildCosTable(legendreCoeffs);
     //lambda
     lambda = [this](double* x, double* p)
     {
@@ -286,9 +306,33 @@ double ActSim::TheoCrossSection::IntegrateTotalXS(double low, double high)
     return xsAtEnergy->Integral(low, high);
 }
 
-double ActSim::TheoCrossSection::SampleXS(TRandom3* generator)
+double ActSim::TheoCrossSection::SampleXS(TRandom* generator)
+{
+    if(cosTable.IsEmpty())
+        throw std::runtime_error("TheoCrossSection::SampleXS(): ComputeXSAtEnergy must be called before");
+    double cosValue { cosTable.Sample(generator)};
+    return TMath::ACos(cosValue);
+}
+
+void ActSim::TheoCrossSection::BuildEnergyTable(double Tmin, double Tmax, int nEnergies)
+{
+    if(nEnergies < 2 || Tmax <= Tmin)
+        throw std::invalid_argument("TheoCrossSection::BuildEnergyTable(): at least 2 energies in Tmax > Tmin needed");
+    cosTable2D.Clear();
+    std::vector<double> coeffs {};
+    for(int i = 0; i < nEnergies; i++)
+    {
+        double Tn { Tmin + (Tmax - Tmin) * i / (nEnergies - 1)};
+        ComputeLegendreCoeffs(Tn, coeffs);
+        cosTable2D.AddTable(Tn, BuildCosTable(coeffs));
+    }
+}
+
+double ActSim::TheoCrossSection::SampleXS(double Tn, TRandom* generator) const
 {
-    double cosValue { xsAtEnergy->GetRandom((generator == nullptr) ? gRandom : generator)};
+    if(cosTable2D.IsEmpty())
+        throw std::runtime_error("TheoCrossSection::SampleXS(): BuildEnergyTable must be called before");
+    double cosValue { cosTable2D.Sample(Tn, generator)};
     return TMath::ACos(cosValue);
 }
 
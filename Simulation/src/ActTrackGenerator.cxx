@@ -12,6 +12,8 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -33,6 +35,8 @@ void ActSim::TrackGenerator::ReadConfiguration(std::shared_ptr<ActRoot::InputBlo
     // 2-> Lengths to pad conversion
     if(block->CheckTokenExists("RangeStep", true))
         fRangeStep = block->GetDouble("RangeStep");
+    if(block->CheckTokenExists("CumulativeRange", true))
+        fCumulativeRange = block->GetBool("CumulativeRange");
     fMaxRangeElectrons = block->GetDouble("MaxRangeElectrons");
     fStartTime = block->GetDouble("StartTime");
     fSamplingFreq = block->GetDouble("SamplingFreq");
@@ -73,7 +77,7 @@ double ActSim::TrackGenerator::AddRecoil(const std::string& which, double Tini,
     // 1-> Build direction
     XYZVector dir {TMath::Cos(theta), TMath::Sin(theta) * TMath::Sin(phi), TMath::Sin(theta) * TMath::Cos(phi)};
     // 2-> Get range
-    auto range {fsrim->EvalDirect(which, Tini)};
+    auto range {fsrim->EvalRange(fsrim->GetHandle(which), Tini)};
     // 3-> Fill
     return FillCloud(which, Tini, range, fVertex, dir);
 }
@@ -84,21 +88,61 @@ double ActSim::TrackGenerator::FillCloud(const std::string& which, double T, dou
     // Add new row
     fCloud.push_back({});
     auto& vector {fCloud.back()};
+    // Resolve key once: table lookups in the loop
+    auto handle {fsrim->GetHandle(which)};
+    if(fCumulativeRange)
+        return FillCloudCumulative(handle, T, l, point, dir);
     // Iterate over range
     for(double r = 0; r <= l; r += fRangeStep)
     {
         auto p {point + r * dir};
         if(!IsInChamber(p))
             break;
-        auto Eit {fsrim->Slow(which, T, fRangeStep)};
+        auto Eit {fsrim->Slow(handle, T, fRangeStep)};
         auto charge {T - Eit};
         if(charge <= 0)
             break;
         vector.push_back({(ActRoot::Voxel::XYZPointF)p, static_cast<float>(charge)});
+        // Next step starts with the energy left after this one
+        T = Eit;
     }
     return T;
 }
 
+double ActSim::TrackGenerator::FillCloudCumulative(int handle, double T, double l, const XYZPoint& point,
+                                                   const XYZVector& dir)
+{
+    auto& vector {fCloud.back()};
+    // Energy after a path r is E(R(T) - r): a single table evaluation per step
+    auto range {fsrim->EvalRange(handle, T)};
+    // 1-> Steps inside chamber, with the residual range at their end
+    fStepR.clear();
+    fStepRes.clear();
+    for(double r = 0; r <= l; r += fRangeStep)
+    {
+        if(!IsInChamber(point + r * dir))
+            break;
+        fStepR.push_back(r);
+        fStepRes.push_back(range - r - fRangeStep);
+        if(fStepRes.back() <= 0)
+            break;
+    }
+    // 2-> Energies at the end of all the steps of this track at once
+    fsrim->EvalEnergy(handle, fStepRes, fStepE);
+    // 3-> Deposit the difference between consecutive steps
+    auto prev {T};
+    for(int i = 0, size = fStepR.size(); i < size; i++)
+    {
+        auto after {(fStepRes[i] <= 0) ? 0 : std::min(prev, fStepE[i])};
+        auto charge {prev - after};
+        if(charge <= 0)
+            break;
+        vector.push_back({(ActRoot::Voxel::XYZPointF)(point + fStepR[i] * dir), static_cast<float>(charge)});
+        prev = after;
+    }
+    return prev;
+}
+
 template <typename T>
 std::pair<int, int> ActSim::TrackGenerator::GetPadRange(const T& p, const std::string& which)
 {
@@ -123,31 +167,32 @@ std::pair<int, int> ActSim::TrackGenerator::GetPadRange(const T& p, const std::s
     return {std::max(0, low), std::min(ref, up)};
 }
 
-double ActSim::TrackGenerator::SpreadCharge(const XYZPoint& p, double x, double y)
+void ActSim::TrackGenerator::FillKernel(double pos, int minPad, int maxPad, std::vector<double>& kernel)
 {
-    // Convert pads to mm
-    x *= ftpc->GetPadSide();
-    y *= ftpc->GetPadSide();
-    // Portions
-    auto low {0.25 * ftpc->GetPadSide()};
-    auto up {0.75 * ftpc->GetPadSide()};
-    // 1-> low, low
-    double val {TMath::Exp(0.5 * (TMath::Power((x + low - p.X()) / fGas->GetTransDiff(), 2) +
-                                  TMath::Power((y + low - p.Y()) / fGas->GetTransDiff(), 2)))};
-    // 2-> up, low
-    val += TMath::Exp(0.5 * (TMath::Power((x + up - p.X()) / fGas->GetTransDiff(), 2) +
-                             TMath::Power((y + low - p.Y()) / fGas->GetTransDiff(), 2)));
-    // 3-> low, up
-    val += TMath::Exp(0.5 * (TMath::Power((x + low - p.X()) / fGas->GetTransDiff(), 2) +
-                             TMath::Power((y + up - p.Y()) / fGas->GetTransDiff(), 2)));
-    // 4-> up, up
-    val += TMath::Exp(0.5 * (TMath::Power((x + up - p.X()) / fGas->GetTransDiff(), 2) +
-                             TMath::Power((y + up - p.Y()) / fGas->GetTransDiff(), 2)));
-    return val;
+    // The 4 terms of the diffusion of a pad, exp(0.5 * (dx^2 + dy^2) / sigma^2) with dx and dy at 1/4 and 3/4
+    // of the pad, factorize into (kx(1/4) + kx(3/4)) * (ky(1/4) + ky(3/4)), so only one row per axis is computed
+    auto side {ftpc->GetPadSide()};
+    auto low {0.25 * side};
+    auto up {0.75 * side};
+    auto sigma {fGas->GetTransDiff()};
+    kernel.resize(maxPad - minPad + 1);
+    for(int pad = minPad; pad <= maxPad; pad++)
+    {
+        auto x {pad * side};
+        auto dlow {(x + low - pos) / sigma};
+        auto dup {(x + up - pos) / sigma};
+        kernel[pad - minPad] = std::exp(0.5 * dlow * dlow) + std::exp(0.5 * dup * dup);
+    }
 }
 
 void ActSim::TrackGenerator::Convert()
 {
+    int npadsY {ftpc->GetNPADSY()};
+    int npads {ftpc->GetNPADSX() * npadsY};
+    if(static_cast<int>(fData.size()) != npads)
+        fData.assign(npads, {});
+    // Constant of charge per electron
+    auto factor {6.55e-4 * 600 * 1. / 2 / TMath::Pi() / std::pow(fGas->GetTransDiff(), 2)};
     for(const auto& track : fCloud)
     {
         for(const auto& raw : track)
@@ -159,36 +204,46 @@ void ActSim::TrackGenerator::Convert()
             auto Ne {q * 1e6 / fGas->GetWork()};
             // Following ACTARSim, use poisson distribution
             Ne = fRand->PoissonD(Ne);
+            // Compute Z value: time bucket
+            auto tb {static_cast<int>((pos.Z()) / fGas->GetVDrift() * fSamplingFreq)};
+            // Append trigger time
+            tb += fStartTime;
+            // Skip if outside range
+            if(tb < 0 || tb > ftpc->GetNPADSZUNREBIN())
+                continue;
             // Get ranges in pads of point
             auto [minPadX, maxPadX] {GetPadRange(pos, "x")};
             auto [minPadY, maxPadY] {GetPadRange(pos, "y")};
+            FillKernel(pos.X(), minPadX, maxPadX, fKernelX);
+            FillKernel(pos.Y(), minPadY, maxPadY, fKernelY);
+            auto tq {factor * Ne};
             // Iterate
             for(int padx = minPadX; padx <= maxPadX; padx++)
             {
+                auto tqx {tq * fKernelX[padx - minPadX]};
                 for(int pady = minPadY; pady <= maxPadY; pady++)
                 {
-                    // Compute Z value: time bucket
-                    auto tb {static_cast<int>((pos.Z()) / fGas->GetVDrift() * fSamplingFreq)};
-                    // Append trigger time
-                    tb += fStartTime;
-                    // Break if outside range
-                    if(tb < 0 || tb > ftpc->GetNPADSZUNREBIN())
-                        break;
-                    // Push
-                    auto tq {6.55e-4 * 600 * Ne * 1. / 2 / TMath::Pi() / TMath::Power(fGas->GetTransDiff(), 2) * 1};
-                    tq *= SpreadCharge(pos, padx, pady);
-                    fData[{padx, pady}].push_back({tb, tq});
+                    auto idx {padx * npadsY + pady};
+                    auto& signal {fData[idx]};
+                    if(signal.empty())
+                        fPadsWithData.push_back(idx);
+                    signal.push_back({tb, tqx * fKernelY[pady - minPadY]});
                 }
             }
         }
     }
+    // Same order of pads as when they were stored in a map of [padx, pady]
+    std::sort(fPadsWithData.begin(), fPadsWithData.end());
     FillMEvent();
 }
 
 void ActSim::TrackGenerator::Reset()
 {
     fCloud.clear();
-    fData.clear();
+    // Keep capacity of signals
+    for(const auto& idx : fPadsWithData)
+        fData[idx].clear();
+    fPadsWithData.clear();
     fMEvent = {};
     fVertex = {-1, -1, -1};
 }
@@ -196,9 +251,12 @@ void ActSim::TrackGenerator::Reset()
 void ActSim::TrackGenerator::Fill2D(TH2* h, const std::string& which)
 {
     h->Reset();
-    for(const auto& [pad, signal] : fData)
+    int npadsY {ftpc->GetNPADSY()};
+    for(const auto& idx : fPadsWithData)
     {
-        auto [x, y] {pad};
+        const auto& signal {fData[idx]};
+        int x {idx / npadsY};
+        int y {idx % npadsY};
         for(const auto& vals : signal)
         {
             auto [z, q] {vals};
@@ -214,9 +272,12 @@ void ActSim::TrackGenerator::Fill2D(TH2* h, const std::string& which)
 
 void ActSim::TrackGenerator::FillMEvent()
 {
-    for(const auto& [pad, signal] : fData)
+    int npadsY {ftpc->GetNPADSY()};
+    for(const auto& idx : fPadsWithData)
     {
-        auto [x, y] {pad};
+        const auto& signal {fData[idx]};
+        int x {idx / npadsY};
+        int y {idx % npadsY};
         // Init legacy data
         ReducedData datared;
         // Convert to globalchannel
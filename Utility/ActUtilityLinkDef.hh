@@ -14,7 +14,11 @@
 #pragma link C++ class ActRoot::CutsManager < string>;
 
 // multithreading
+#pragma link C++ class ActRoot::ChunkScheduler;
 #pragma link C++ class ActRoot::MTExecutor;
+#pragma link C++ class ActRoot::MTSimExecutor;
+#pragma link C++ class ActRoot::TPCSimWorker;
+#pragma link C++ class ActRoot::TPCSimRecoWorker;
 #pragma link C++ class ActRoot::ProgressBar;
 
 // ActRoot's GUI
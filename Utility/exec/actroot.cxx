@@ -2,12 +2,20 @@
 #include "ActDetectorManager.h"
 #include "ActInputData.h"
 #include "ActMTExecutor.h"
+#include "ActMTSimExecutor.h"
 #include "ActOptions.h"
 #include "ActOutputData.h"
+#include "ActTPCSimRecoWorker.h"
+#include "ActTPCSimWorker.h"
 #include "ActTypes.h"
 
+#include "TTree.h"
+
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
 
 int main(int argc, char* argv[])
 {
@@ -27,7 +35,21 @@ int main(int argc, char* argv[])
         ActRoot::DataManager datman {opts->GetMode()};
         datman.ReadDataFile(opts->GetDataFile());
 
-        if(opts->GetIsMT())
+        if(opts->GetMode() == ActRoot::ModeType::ESimu || opts->GetMode() == ActRoot::ModeType::ESimuReco)
+        {
+            // Same executor in ST mode, with a single thread
+            auto conf {opts->GetConfigDir() + "simulation.conf"};
+            ActRoot::MTSimExecutor sim {opts->GetIsMT() ? static_cast<int>(std::thread::hardware_concurrency()) : 1};
+            sim.ReadConfiguration(conf);
+            sim.SetDataManager(&datman);
+            if(opts->GetMode() == ActRoot::ModeType::ESimuReco)
+                sim.SetWorkerFactory(
+                    ActRoot::TPCSimRecoWorker::BuildFactory(conf, opts->GetDetFile(), opts->GetCalFile()));
+            else
+                sim.SetWorkerFactory(ActRoot::TPCSimWorker::BuildFactory(conf));
+            sim.Run();
+        }
+        else if(opts->GetIsMT())
         {
             ActRoot::MTExecutor mt;
             mt.SetDataManager(&datman);
@@ -38,7 +60,10 @@ int main(int argc, char* argv[])
         {
             // Init input and output
             auto input {datman.GetInput()};
-            auto output {datman.GetOuput()};
+            // More than one output when decoding raw data in a single pass
+            std::vector<ActRoot::OutputData> outputs;
+            for(const auto& mode : datman.GetOutputModes())
+                outputs.push_back(datman.GetOuput(mode));
 
             ActRoot::DetectorManager detman {opts->GetMode()};
             detman.ReadDetectorFile(opts->GetDetFile());
@@ -50,20 +75,28 @@ int main(int argc, char* argv[])
             {
                 std::cout << "Building event data for run " << run << '\n';
                 detman.InitInput(input.GetTree(run));
-                detman.InitOutput(output.GetTree(run));
+                std::vector<std::shared_ptr<TTree>> trees;
+                for(auto& output : outputs)
+                    trees.push_back(output.GetTree(run));
+                detman.InitOutput(trees);
                 int nentries {input.GetNEntries(run)};
                 for(int entry = 0; entry < nentries; entry++)
                 {
                     std::cout << "\r" << entry << std::flush;
                     input.GetEntry(run, entry);
                     detman.BuildEvent(run, entry);
-                    output.Fill(run);
+                    for(auto& output : outputs)
+                        output.Fill(run);
                 }
-                output.Close(run);
+                for(auto& output : outputs)
+                    output.Close(run);
                 input.Close(run);
                 std::cout << '\n' << "->Processed events = " << nentries << '\n';
             }
             detman.PrintReports();
+            input.PrintPrefetchStats();
+            for(auto& output : outputs)
+                output.PrintAsyncStats();
             timer.Stop();
             timer.Print();
         }
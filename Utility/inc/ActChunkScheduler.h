@@ -0,0 +1,85 @@
+#ifndef ActChunkScheduler_h
+#define ActChunkScheduler_h
+
+#include "ActProgressBar.h"
+
+#include "BS_thread_pool.h"
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ActRoot
+{
+//! Splits runs into chunks of contiguous entries and runs them on a thread pool
+/*!
+  Chunks are dealt round-robin to the workers, which take them in increasing order and, once
+  they run out of work, steal chunks from the back of the other workers' queues.
+  Common to MTExecutor and MTSimExecutor: they only define what is done with a chunk
+*/
+class ChunkScheduler
+{
+public:
+    //! Unit of work: a range of entries [fBegin, fEnd) of a run
+    class Chunk
+    {
+    public:
+        int fRun {};
+        int fBegin {};
+        int fEnd {};
+        int fIdx {}; //!< Position of chunk inside its run
+    };
+    //! Queue of chunks of a worker, from which idle workers steal
+    class WorkQueue
+    {
+    public:
+        std::mutex fMutex {};
+        std::deque<Chunk> fChunks {};
+    };
+    //! Process a chunk. count is the number of chunks processed by the thread, this one included
+    using ChunkFunc = std::function<void(unsigned int thread, const Chunk& chunk, unsigned int count)>;
+    //! Called once by each worker when there is no work left
+    using ThreadFunc = std::function<void(unsigned int thread)>;
+
+private:
+    // Queue of chunks per worker
+    std::vector<std::shared_ptr<WorkQueue>> fQueues;
+    // Number of entries and chunks per run
+    std::map<int, int> fEntriesPerRun {};
+    std::map<int, int> fChunksPerRun {};
+    int fNChunks {};
+    int fNWorkers {};
+    int fSize {}; //!< Chunk size actually used
+    // Chunk size in entries (automatically computed if <= 0)
+    int fChunkSize {};
+    int fMinChunkSize {1000};
+    int fChunksPerWorker {4}; //!< Target number of chunks per worker in automatic mode
+
+public:
+    ChunkScheduler() = default;
+
+    // Setters
+    void SetChunkSize(int size) { fChunkSize = size; }
+    void SetMinChunkSize(int size) { fMinChunkSize = size; }
+    void SetChunksPerWorker(int n) { fChunksPerWorker = n; }
+
+    //! Split entries of each run and deal them to at most nthreads workers
+    void Build(const std::map<int, int>& entries, int nthreads);
+    bool Pop(unsigned int thread, Chunk& chunk);
+    //! Run all chunks in the pool, with progress bar and timer. Blocks until they end
+    void Run(BS::thread_pool& tp, ProgressBar& bar, const ChunkFunc& process, const ThreadFunc& finish = {});
+
+    // Getters
+    const std::map<int, int>& GetChunksPerRun() const { return fChunksPerRun; }
+    int GetNChunks() const { return fNChunks; }
+    int GetNWorkers() const { return fNWorkers; }
+
+    void Print(const std::string& title, const std::string& unit) const;
+};
+} // namespace ActRoot
+
+#endif
@@ -1,14 +1,18 @@
 #ifndef ActMTExecutor_h
 #define ActMTExecutor_h
 
+#include "ActChunkScheduler.h"
 #include "ActDataManager.h"
 #include "ActDetectorManager.h"
+#include "ActInputData.h"
+#include "ActInputPrefetcher.h"
 #include "ActProgressBar.h"
 
 #include "BS_thread_pool.h"
 #include "BS_thread_pool_utils.h"
 
-#include <set>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
@@ -16,8 +20,16 @@
 namespace ActRoot
 {
 //! A class to perform multiple tasks in MT mode (experimental!)
+/*!
+  Runs are split into chunks of contiguous entries, scheduled with work stealing by a
+  ChunkScheduler. Chunks of a run are written in order to a single file through
+  ParallelOutputData, so output is independent of the scheduling
+*/
 class MTExecutor
 {
+public:
+    using Chunk = ChunkScheduler::Chunk;
+
 private:
     // Cout
     BS::synced_stream ftpcout;
@@ -27,20 +39,24 @@ private:
     DataManager* fDatMan {};
     // Vector of DetMan for workers
     std::vector<DetectorManager> fDetMans;
-    // List of runs per worker
-    std::vector<std::set<int>> fRunsPerThread;
+    // Chunks of runs and their queues
+    ChunkScheduler fScheduler {};
+    // Read-ahead statistics of InputData, summed over workers
+    InputPrefetcher::Stats fIOStats {};
+    std::mutex fIOMutex {};
     // Progress bar
     ProgressBar fProgBar;
 
 public:
     MTExecutor(int nthreads = 1.5 * std::thread::hardware_concurrency());
+    void SetChunkSize(int size) { fScheduler.SetChunkSize(size); }
     void SetDataManager(DataManager* datman);
     void SetDetectorConfig(const std::string& detfile, const std::string& calfile);
     void BuildEvent();
 
 private:
-    void ComputeRunsPerThread();
-    bool IsThreadEmpty(int t);
+    void ComputeChunks();
+    void CloseInput(InputData& input, int run);
 };
 } // namespace ActRoot
 
@@ -0,0 +1,96 @@
+#ifndef ActMTSimExecutor_h
+#define ActMTSimExecutor_h
+
+#include "ActChunkScheduler.h"
+#include "ActDataManager.h"
+#include "ActProgressBar.h"
+#include "ActRandomStream.h"
+
+#include "TRandom.h"
+#include "TTree.h"
+
+#include "BS_thread_pool.h"
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ActRoot
+{
+//! A class to run simulations in MT mode, reproducible event by event
+/*!
+  The events of each run are split into chunks of contiguous entries, scheduled by a
+  ChunkScheduler and written to a single file per run through ParallelOutputData,
+  as in MTExecutor. Each thread owns a SimWorker built by a user factory, which must hold
+  its own generators (TrackGenerator, KinematicGenerator...) and only share read-only
+  objects: SRIM through its handle functions, SilSpecs, Geometry...
+  Before each event, the RandomStream of the thread is restarted from (seed, run, entry),
+  so as long as workers draw only from it and keep no state between events, the output
+  does not depend on the number of threads nor on the chunk size.
+  Beware that TGenPhaseSpace draws from the global gRandom: in a worker, sample angles
+  with the given generator and compute the kinematics with ActPhysics::Kinematics, as
+  TPCSimWorker does. actroot -sim runs that worker from configs/simulation.conf, and
+  actroot -simreco runs TPCSimRecoWorker, which also reconstructs each event up to Merger
+*/
+class MTSimExecutor
+{
+public:
+    //! Part of a simulation run by a single thread
+    class SimWorker
+    {
+    public:
+        virtual ~SimWorker() = default;
+        //! Attach branches to the output tree of a chunk
+        virtual void InitOutput(std::shared_ptr<TTree> tree) = 0;
+        //! Simulate an event drawing numbers only from rand. Return true to write it
+        virtual bool Simulate(int run, int entry, TRandom* rand) = 0;
+    };
+    using WorkerFactory = std::function<std::shared_ptr<SimWorker>(unsigned int thread)>;
+    using Chunk = ChunkScheduler::Chunk;
+
+private:
+    // Thread pool
+    BS::thread_pool ftp;
+    // Pointer to DataManager, with run list and [Simu] output block
+    DataManager* fDatMan {};
+    // Builder of workers and workers themselves
+    WorkerFactory fFactory {};
+    std::vector<std::shared_ptr<SimWorker>> fWorkers {};
+    std::vector<RandomStream> fRands {};
+    unsigned long long fSeed {};
+    unsigned long long fStream {1}; //!< Different from the default of TPCDetector so reconstruction does not reuse numbers
+    // Events to simulate
+    int fNEvents {};                        //!< For runs not set in fEventsPerRun
+    std::map<int, int> fEventsPerRun {};
+    // Chunks of runs and their queues
+    ChunkScheduler fScheduler {};
+    // Progress bar
+    ProgressBar fProgBar;
+
+public:
+    MTSimExecutor(int nthreads = std::thread::hardware_concurrency());
+
+    // Setters
+    void SetDataManager(DataManager* datman) { fDatMan = datman; }
+    void SetWorkerFactory(const WorkerFactory& factory) { fFactory = factory; }
+    void SetNEvents(int nevents) { fNEvents = nevents; }
+    void SetNEvents(int run, int nevents) { fEventsPerRun[run] = nevents; }
+    void SetChunkSize(int size) { fScheduler.SetChunkSize(size); }
+    void SetSeed(unsigned long long seed) { fSeed = seed; }
+    void SetStream(unsigned long long stream) { fStream = stream; }
+    //! NEvents and Seed, and optionally ChunkSize, from the [Simulation] block of file
+    void ReadConfiguration(const std::string& file);
+
+    // Run the simulation
+    void Run();
+
+private:
+    void ComputeChunks();
+    void InitWorkers();
+};
+} // namespace ActRoot
+
+#endif
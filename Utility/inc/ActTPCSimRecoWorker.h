@@ -0,0 +1,68 @@
+#ifndef ActTPCSimRecoWorker_h
+#define ActTPCSimRecoWorker_h
+
+#include "ActDetectorManager.h"
+#include "ActMTSimExecutor.h"
+#include "ActTPCSimWorker.h"
+
+#include "TRandom.h"
+#include "TTree.h"
+
+#include <memory>
+#include <string>
+
+// forward declarations
+namespace ActPhysics
+{
+class SilSpecs;
+}
+
+namespace ActRoot
+{
+class SilData;
+class ModularData;
+
+//! TPCSimWorker whose events are reconstructed in memory up to MergerData
+/*!
+  Each worker owns a DetectorManager in ESimuReco mode: the simulated MEventReduced goes
+  through TPC, its filter and Merger without being written. Silicon data is the light recoil
+  at the first silicon it reaches (SilSpecs of Merger), slowed down in the gas up to it and
+  assumed to stop there. Finer thresholds are applied later by Merger.
+  Output is the truth of the reaction and MergerData
+*/
+class TPCSimRecoWorker : public TPCSimWorker
+{
+private:
+    DetectorManager fDetMan {ModeType::ESimuReco};
+    std::shared_ptr<ActPhysics::SilSpecs> fSilSpecs {};
+    SilData* fSilData {};         //!< Owned by SilDetector: refreshed at each InitOutput
+    ModularData* fModularData {}; //!< Owned by ModularDetector: refreshed at each InitOutput
+    int fLightHandle {};          //!< Of light table in SRIM
+    float fGATCONF {};            //!< Stored in ModularData of every event if fHasGATCONF
+    bool fHasGATCONF {};
+
+public:
+    TPCSimRecoWorker(std::shared_ptr<Shared> shared, const std::string& detfile, bool print = false);
+
+    void InitOutput(std::shared_ptr<TTree> tree) override;
+    //! Returns false if the beam stops or falls below threshold before the vertex
+    bool Simulate(int run, int entry, TRandom* rand) override;
+
+    DetectorManager& GetDetMan() { return fDetMan; }
+    void SetGATCONF(float gat)
+    {
+        fGATCONF = gat;
+        fHasGATCONF = true;
+    }
+
+    //! As TPCSimWorker::BuildFactory, plus detector and calibration files of reconstruction.
+    //! [Simulation] block can also set GATCONF, for Merger with ForceGATCONF
+    static MTSimExecutor::WorkerFactory
+    BuildFactory(const std::string& file, const std::string& detfile, const std::string& calfile);
+
+private:
+    void FillSilicons();
+};
+} // namespace ActRoot
+
+#endif
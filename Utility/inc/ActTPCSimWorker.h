@@ -0,0 +1,93 @@
+#ifndef ActTPCSimWorker_h
+#define ActTPCSimWorker_h
+
+#include "ActKinematics.h"
+#include "ActMTSimExecutor.h"
+#include "ActTrackGenerator.h"
+
+#include "TRandom.h"
+#include "TTree.h"
+
+#include "Math/Point3D.h"
+
+#include <memory>
+#include <string>
+
+// forward declarations
+namespace ActPhysics
+{
+class SRIM;
+class Gas;
+} // namespace ActPhysics
+
+namespace ActSim
+{
+class CrossSection;
+}
+
+namespace ActRoot
+{
+class TPCParameters;
+class CalibrationManager;
+class InputBlock;
+
+//! SimWorker of a binary reaction in the TPC, built on ActSim::TrackGenerator
+/*!
+  For each event: vertex, beam slowed down up to it, reaction at a thetaCM sampled from
+  a CrossSection (isotropic if not given) and light and heavy recoils converted to pad signals.
+  Every number is drawn from the generator of the thread, set in the TrackGenerator with
+  SetTRandom. The reaction is computed with ActPhysics::Kinematics instead of KinematicGenerator,
+  whose TGenPhaseSpace draws from gRandom. SRIM, TPC, gas, calibrations and cross section
+  are read once and shared read-only by all the workers
+*/
+class TPCSimWorker : public MTSimExecutor::SimWorker
+{
+public:
+    using XYZPoint = ROOT::Math::XYZPoint;
+    //! Read-only objects shared by all the workers
+    class Shared
+    {
+    public:
+        std::shared_ptr<ActPhysics::SRIM> fSRIM {}; //!< Tables keyed as beam, light and heavy
+        std::shared_ptr<TPCParameters> fTPC {};
+        std::shared_ptr<ActPhysics::Gas> fGas {};
+        std::shared_ptr<CalibrationManager> fCalMan {}; //!< With the inverted look up table
+        std::shared_ptr<ActSim::CrossSection> fXS {};   //!< Of thetaCM in degrees. Isotropic if null
+        std::shared_ptr<InputBlock> fTrackBlock {};
+        std::shared_ptr<InputBlock> fKinBlock {};
+    };
+
+protected:
+    std::shared_ptr<Shared> fShared {};
+    ActSim::TrackGenerator fTracks {};
+    ActPhysics::Kinematics fKin {};
+    double fTBeam {}; //!< Beam energy at entrance of the chamber
+    // Output
+    MEventReduced* fMEvent {};
+    XYZPoint fVertex {};
+    double fTVertex {};
+    double fThetaCM {};
+    double fT3 {};
+    double fTheta3 {};
+    double fT4 {};
+    double fTheta4 {};
+
+public:
+    TPCSimWorker(std::shared_ptr<Shared> shared);
+
+    //! Raw data as MEventReduced and truth of the reaction
+    void InitOutput(std::shared_ptr<TTree> tree) override;
+    //! Returns false if the beam stops or falls below threshold before the vertex
+    bool Simulate(int run, int entry, TRandom* rand) override;
+
+    //! Read shared objects from file. [Simulation] block: BeamSRIM, LightSRIM, HeavySRIM, TPC, InvLookUp and
+    //! optionally REBINZ and CrossSection. Also [Gas], [Kinematics] and [TrackGenerator] blocks
+    static std::shared_ptr<Shared> ReadShared(const std::string& file);
+    static MTSimExecutor::WorkerFactory BuildFactory(const std::string& file);
+
+protected:
+    void InitTruthOutput(std::shared_ptr<TTree> tree);
+};
+} // namespace ActRoot
+
+#endif
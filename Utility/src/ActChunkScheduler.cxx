@@ -0,0 +1,128 @@
+#include "ActChunkScheduler.h"
+
+#include "ActColors.h"
+#include "ActProgressBar.h"
+
+#include "TStopwatch.h"
+
+#include "BS_thread_pool.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+void ActRoot::ChunkScheduler::Build(const std::map<int, int>& entries, int nthreads)
+{
+    fEntriesPerRun = entries;
+    long long total {};
+    for(const auto& [run, nentries] : entries)
+        total += nentries;
+    // Size of chunk: if not set, aim at a few chunks per thread so idle workers
+    // have something to steal, but avoid too small chunks (partial files have an overhead)
+    fSize = fChunkSize;
+    if(fSize <= 0)
+        fSize = static_cast<int>(
+            std::max<long long>(fMinChunkSize, total / (static_cast<long long>(nthreads) * fChunksPerWorker)));
+    // Build chunks in order of run and entry
+    std::vector<Chunk> chunks;
+    fChunksPerRun.clear();
+    for(const auto& [run, nentries] : entries)
+    {
+        int idx {};
+        for(int begin = 0; begin < nentries; begin += fSize)
+            chunks.push_back({run, begin, std::min(begin + fSize, nentries), idx++});
+        // Empty runs still need an (empty) output file
+        if(nentries == 0)
+            chunks.push_back({run, 0, 0, idx++});
+        fChunksPerRun[run] = idx;
+    }
+    fNChunks = chunks.size();
+    // Number of workers can be less than thread pool size if there are less chunks than threads
+    fNWorkers = std::min(nthreads, fNChunks);
+    fQueues.clear();
+    for(int w = 0; w < fNWorkers; w++)
+        fQueues.push_back(std::make_shared<WorkQueue>());
+    // Deal chunks round-robin: consecutive chunks run at the same time, so the ordered
+    // writer of ParallelOutputData can flush them without parking most of the run in memory
+    for(int i = 0; i < fNChunks; i++)
+        fQueues[i % fNWorkers]->fChunks.push_back(chunks[i]);
+}
+
+bool ActRoot::ChunkScheduler::Pop(unsigned int thread, Chunk& chunk)
+{
+    // 1-> Own queue: from the front
+    {
+        auto& own {*fQueues[thread]};
+        std::lock_guard<std::mutex> lock {own.fMutex};
+        if(!own.fChunks.empty())
+        {
+            chunk = own.fChunks.front();
+            own.fChunks.pop_front();
+            return true;
+        }
+    }
+    // 2-> Steal from the back of other queues
+    for(int i = 1; i < fNWorkers; i++)
+    {
+        auto& victim {*fQueues[(thread + i) % fNWorkers]};
+        std::lock_guard<std::mutex> lock {victim.fMutex};
+        if(!victim.fChunks.empty())
+        {
+            chunk = victim.fChunks.back();
+            victim.fChunks.pop_back();
+            return true;
+        }
+    }
+    // No work left: chunks are never added once Run starts
+    return false;
+}
+
+void ActRoot::ChunkScheduler::Run(BS::thread_pool& tp, ProgressBar& bar, const ChunkFunc& process,
+                                  const ThreadFunc& finish)
+{
+    auto work = [&](unsigned int thread)
+    {
+        unsigned int count {1};
+        Chunk chunk;
+        while(Pop(thread, chunk))
+        {
+            bar.SetThreadInfo(thread, chunk.fEnd - chunk.fBegin, fNChunks);
+            process(thread, chunk, count++);
+        }
+        if(finish)
+            finish(thread);
+        bar.IncrementCompleted(); // increase inner atomic telling monitor that task ended
+    };
+    // Add a global timer
+    TStopwatch timer {};
+    timer.Start();
+    // Start monitor
+    bar.SetNThreads(fNWorkers);
+    bar.Init();
+    // Parallelize loop
+    tp.detach_sequence(0, fNWorkers, work);
+    // Wait for tasks to finish
+    tp.wait();
+    // End monitor thread once tasks have finished
+    bar.Join();
+    // Finish execution by couting elapased time
+    timer.Stop();
+    std::cout << std::endl;
+    timer.Print();
+}
+
+void ActRoot::ChunkScheduler::Print(const std::string& title, const std::string& unit) const
+{
+    std::cout << BOLDYELLOW << "----- " << title << " -----" << '\n';
+    std::cout << "Chunk size : " << fSize << " " << unit << '\n';
+    for(const auto& [run, nentries] : fEntriesPerRun)
+        std::cout << "Run " << std::setw(5) << run << " : " << std::setw(9) << nentries << " " << unit << " in "
+                  << fChunksPerRun.at(run) << " chunks" << '\n';
+    std::cout << "------------------------" << '\n';
+    std::cout << RESET;
+}
@@ -1,25 +1,32 @@
 #include "ActMTExecutor.h"
 
+#include "ActChunkScheduler.h"
 #include "ActColors.h"
 #include "ActDetectorManager.h"
 #include "ActInputData.h"
+#include "ActInputPrefetcher.h"
 #include "ActOptions.h"
 #include "ActOutputData.h"
+#include "ActParallelOutputData.h"
 #include "ActProgressBar.h"
+#include "ActTPCDetector.h"
+#include "ActVFilter.h"
 
 #include "TFile.h"
 #include "TROOT.h"
-#include "TStopwatch.h"
+#include "TTree.h"
 
 #include "BS_thread_pool.h"
 
-#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <vector>
 
-ActRoot::MTExecutor::MTExecutor(int nthreads) : ftp(BS::thread_pool(nthreads)), fRunsPerThread(nthreads), fProgBar()
+ActRoot::MTExecutor::MTExecutor(int nthreads) : ftp(BS::thread_pool(nthreads)), fProgBar()
 {
     // Mandatory to be very cautious with concurrency
     ROOT::EnableThreadSafety();
@@ -30,115 +37,118 @@ void ActRoot::MTExecutor::SetDataManager(DataManager* datman)
 {
     // Assign
     fDatMan = datman;
-    // Compute runs per worker
-    ComputeRunsPerThread();
+    // Split runs into chunks and assign them to workers
+    ComputeChunks();
 }
 
 void ActRoot::MTExecutor::SetDetectorConfig(const std::string& detfile, const std::string& calfile)
 {
-    for(int thread = 0; thread < fRunsPerThread.size(); thread++)
+    // Number of workers can be less than thread pool size if there are less chunks than threads
+    for(int thread = 0; thread < fScheduler.GetNWorkers(); thread++)
     {
-        if(IsThreadEmpty(thread)) // skip empty threads
-            continue;             // so number of workers can be less than thread pool size
         fDetMans.push_back(DetectorManager {ActRoot::Options::GetInstance()->GetMode()});
+        // Algorithms hold per-event state, so each worker parses its own configuration
         fDetMans.back().ReadDetectorFile(detfile, (thread == 0) ? true : false);
-        fDetMans.back().ReadCalibrationsFile(calfile);
+        // But calibrations (LT, pad alignment, silicons...) are read once and shared read-only
+        if(thread == 0)
+            fDetMans.back().ReadCalibrationsFile(calfile);
+        else
+            fDetMans.back().SetCalMan(fDetMans.front().GetCalMan());
     }
     // Print
-    std::cout << BOLDYELLOW << "Pool size : " << fRunsPerThread.size() << " but DetMan size : " << fDetMans.size()
+    std::cout << BOLDYELLOW << "Pool size : " << ftp.get_thread_count() << " but DetMan size : " << fDetMans.size()
               << RESET << '\n';
-    // Init Progress bar (referred as monitor later)
-    fProgBar.SetNThreads(fDetMans.size());
 }
 
-void ActRoot::MTExecutor::ComputeRunsPerThread()
+void ActRoot::MTExecutor::ComputeChunks()
 {
-    auto runs {fDatMan->GetRunList()};
-    auto nthreads {static_cast<int>(ftp.get_thread_count())};
-    int idx {};
-    for(const auto& run : runs)
+    // Get number of entries per run
+    std::map<int, int> entries;
+    for(const auto& run : fDatMan->GetRunList())
     {
-        if(idx == nthreads)
-            idx = 0;
-        fRunsPerThread[idx].insert(run);
-        idx++;
+        auto input {fDatMan->GetInputForThread({run})};
+        entries[run] = input.GetNEntries(run);
+        input.Close(run);
     }
-
-    // Print
-    std::cout << BOLDYELLOW << "----- MTExecutor -----" << '\n';
-    for(int t = 0; t < fRunsPerThread.size(); t++)
-    {
-        if(IsThreadEmpty(t))
-            continue;
-        std::cout << "Thread " << t << '\n';
-        int count {};
-        int w {5};
-        int s {1};
-        int ncols {4};
-        for(auto& run : fRunsPerThread[t])
-        {
-            std::cout << std::setw(w) << run << std::string(s, ' ');
-            count++;
-            // Display as columns
-            if(count % ncols == 0)
-                std::cout << '\n';
-        }
-        // Close last column
-        if(count % ncols != 0)
-            std::cout << '\n';
-        std::cout << "------------------------" << '\n';
-    }
-    std::cout << RESET;
+    fScheduler.Build(entries, static_cast<int>(ftp.get_thread_count()));
+    fScheduler.Print("MTExecutor", "entries");
 }
 
-bool ActRoot::MTExecutor::IsThreadEmpty(int t)
+void ActRoot::MTExecutor::CloseInput(InputData& input, int run)
 {
-    return fRunsPerThread.at(t).size() == 0;
+    input.Close(run);
+    // Stats are stored per InputData, which is replaced for each run
+    std::lock_guard<std::mutex> lock {fIOMutex};
+    fIOStats.Add(input.GetPrefetchStats());
 }
 
 void ActRoot::MTExecutor::BuildEvent()
 {
-    // Build lambda for each worker
-    auto build = [this](unsigned int thread)
+    // Single output per run and tier, filled concurrently by all workers
+    std::vector<ParallelOutputData> outputs;
+    for(const auto& mode : fDatMan->GetOutputModes())
+    {
+        outputs.push_back(fDatMan->GetParallelOutput(fScheduler.GetChunksPerRun(), mode));
+        // Workers run consecutive chunks: a margin over their number before waiting for the writer
+        outputs.back().SetMaxAhead(2 * fScheduler.GetNWorkers());
+    }
+    // Input is kept open while consecutive chunks of a worker belong to the same run
+    std::vector<InputData> inputs(fDetMans.size());
+    std::vector<int> currents(fDetMans.size(), -1);
+    auto build = [this, &outputs, &inputs, &currents](unsigned int thread, const Chunk& chunk, unsigned int count)
     {
-        unsigned int count {1};
-        for(const auto& run : fRunsPerThread[thread])
+        auto& input {inputs[thread]};
+        auto& current {currents[thread]};
+        auto run {chunk.fRun};
+        if(run != current)
         {
-            // Init in/out data
-            auto input {fDatMan->GetInputForThread({run})};
-            auto output {fDatMan->GetOutputForThread({run})};
-            // Send them to detectors
+            if(current != -1)
+                CloseInput(input, current);
+            input = fDatMan->GetInputForThread({run});
             fDetMans[thread].InitInput(input.GetTree(run));
-            fDetMans[thread].InitOutput(output.GetTree(run));
-            auto nentries {input.GetNEntries(run)};
-            fProgBar.SetThreadInfo(thread, nentries, fRunsPerThread[thread].size());
-            // Run for each entry!
-            for(int entry = 0; entry < nentries; entry++)
-            {
-                input.GetEntry(run, entry);
-                fDetMans[thread].BuildEvent(run, entry);
-                output.Fill(run);
-                fProgBar.SetThreadStatus(thread, entry, nentries, run, count);
-            }
-            output.Close(run);
-            input.Close(run);
-            count++;
+            current = run;
         }
-        fProgBar.IncrementCompleted(); // increase inner atomic telling monitor that task ended
+        std::vector<std::shared_ptr<ParallelOutputData::Chunk>> outs;
+        std::vector<std::shared_ptr<TTree>> trees;
+        for(auto& output : outputs)
+        {
+            outs.push_back(output.GetChunk(run, chunk.fIdx));
+            trees.push_back(outs.back()->fTree);
+        }
+        fDetMans[thread].InitOutput(trees);
+        auto nentries {chunk.fEnd - chunk.fBegin};
+        // Run for each entry!
+        for(int entry = chunk.fBegin; entry < chunk.fEnd; entry++)
+        {
+            input.GetEntry(run, entry);
+            fDetMans[thread].BuildEvent(run, entry);
+            for(int o = 0; o < outputs.size(); o++)
+                outputs[o].Fill(outs[o]);
+            fProgBar.SetThreadStatus(thread, entry - chunk.fBegin, nentries, run, count);
+        }
+        for(int o = 0; o < outputs.size(); o++)
+            outputs[o].Commit(outs[o]);
     };
-    // Add a global timer
-    TStopwatch timer {};
-    timer.Start();
-    // Start monitor
-    fProgBar.Init();
-    // Parallelize loop
-    ftp.detach_sequence(0, (int)fDetMans.size(), build);
-    // Wait for tasks to finish
-    ftp.wait();
-    // End monitor thread once tasks have finished
-    fProgBar.Join();
-    // Finish execution by couting elapased time
-    timer.Stop();
-    std::cout << std::endl;
-    timer.Print();
+    auto close = [this, &inputs, &currents](unsigned int thread)
+    {
+        if(currents[thread] != -1)
+            CloseInput(inputs[thread], currents[thread]);
+    };
+    fScheduler.Run(ftp, fProgBar, build, close);
+    if(fIOStats.fNServed > 0)
+        fIOStats.Print();
+    for(const auto& output : outputs)
+        if(auto stats {output.GetAsyncStats()}; stats.fNFilled > 0)
+            stats.Print();
+    // Filter reports of all threads, accumulated in the first one
+    auto mode {ActRoot::Options::GetInstance()->GetMode()};
+    if(mode == ModeType::EFilter || mode == ModeType::EFilterMerge)
+    {
+        auto filter {fDetMans.front().GetDetectorAs<TPCDetector>()->GetFilter()};
+        bool merged {filter != nullptr};
+        for(int t = 1, size = fDetMans.size(); t < size && merged; t++)
+            merged = filter->MergeReports(*fDetMans[t].GetDetectorAs<TPCDetector>()->GetFilter());
+        if(merged)
+            filter->PrintReports();
+    }
 }
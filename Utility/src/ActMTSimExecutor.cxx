@@ -0,0 +1,101 @@
+#include "ActMTSimExecutor.h"
+
+#include "ActChunkScheduler.h"
+#include "ActColors.h"
+#include "ActDataManager.h"
+#include "ActInputParser.h"
+#include "ActParallelOutputData.h"
+#include "ActProgressBar.h"
+#include "ActRandomStream.h"
+#include "ActTypes.h"
+
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "BS_thread_pool.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+ActRoot::MTSimExecutor::MTSimExecutor(int nthreads) : ftp(BS::thread_pool(nthreads)), fProgBar()
+{
+    // Events of a simulation are cheap to split, so the minimum is lower than in MTExecutor
+    fScheduler.SetMinChunkSize(100);
+    // Workers create and fill their own TTrees
+    ROOT::EnableThreadSafety();
+}
+
+void ActRoot::MTSimExecutor::ReadConfiguration(const std::string& file)
+{
+    ActRoot::InputParser parser {file};
+    auto block {parser.GetBlock("Simulation")};
+    fNEvents = block->GetInt("NEvents");
+    fSeed = block->GetInt("Seed");
+    if(block->CheckTokenExists("ChunkSize", true))
+        fScheduler.SetChunkSize(block->GetInt("ChunkSize"));
+}
+
+void ActRoot::MTSimExecutor::ComputeChunks()
+{
+    // Number of events per run
+    std::map<int, int> events;
+    for(const auto& run : fDatMan->GetRunList())
+    {
+        auto it {fEventsPerRun.find(run)};
+        events[run] = (it != fEventsPerRun.end()) ? it->second : fNEvents;
+    }
+    fScheduler.Build(events, static_cast<int>(ftp.get_thread_count()));
+    std::cout << BOLDYELLOW << "Seed : " << fSeed << RESET << '\n';
+    fScheduler.Print("MTSimExecutor", "events");
+}
+
+void ActRoot::MTSimExecutor::InitWorkers()
+{
+    fWorkers.clear();
+    fRands.clear();
+    // Built sequentially: factories usually read configuration files
+    for(int thread = 0; thread < fScheduler.GetNWorkers(); thread++)
+    {
+        fWorkers.push_back(fFactory(thread));
+        if(!fWorkers.back())
+            throw std::runtime_error("MTSimExecutor::InitWorkers(): factory returned a null worker");
+        fRands.push_back(RandomStream {fSeed, fStream});
+    }
+}
+
+void ActRoot::MTSimExecutor::Run()
+{
+    if(!fDatMan)
+        throw std::runtime_error("MTSimExecutor::Run(): DataManager not set");
+    if(!fFactory)
+        throw std::runtime_error("MTSimExecutor::Run(): worker factory not set");
+    ComputeChunks();
+    InitWorkers();
+    // Single output per run, filled concurrently by all workers
+    auto output {fDatMan->GetParallelOutput(fScheduler.GetChunksPerRun(), ModeType::ESimu)};
+    output.SetMaxAhead(2 * fScheduler.GetNWorkers());
+    auto simu = [this, &output](unsigned int thread, const Chunk& chunk, unsigned int count)
+    {
+        auto& worker {*fWorkers[thread]};
+        auto& rand {fRands[thread]};
+        auto out {output.GetChunk(chunk.fRun, chunk.fIdx)};
+        worker.InitOutput(out->fTree);
+        auto nevents {chunk.fEnd - chunk.fBegin};
+        // Run for each event!
+        for(int entry = chunk.fBegin; entry < chunk.fEnd; entry++)
+        {
+            rand.SetEvent(chunk.fRun, entry);
+            if(worker.Simulate(chunk.fRun, entry, &rand))
+                output.Fill(out);
+            fProgBar.SetThreadStatus(thread, entry - chunk.fBegin, nevents, chunk.fRun, count);
+        }
+        output.Commit(out);
+    };
+    fScheduler.Run(ftp, fProgBar, simu);
+    if(auto stats {output.GetAsyncStats()}; stats.fNFilled > 0)
+        stats.Print();
+}
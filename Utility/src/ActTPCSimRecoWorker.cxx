@@ -0,0 +1,102 @@
+#include "ActTPCSimRecoWorker.h"
+
+#include "ActCalibrationManager.h"
+#include "ActDetectorManager.h"
+#include "ActInputParser.h"
+#include "ActMTSimExecutor.h"
+#include "ActMergerDetector.h"
+#include "ActModularData.h"
+#include "ActModularDetector.h"
+#include "ActSRIM.h"
+#include "ActSilData.h"
+#include "ActSilDetector.h"
+#include "ActSilSpecs.h"
+#include "ActTPCSimWorker.h"
+
+#include "TMath.h"
+#include "TRandom.h"
+#include "TTree.h"
+
+#include "Math/Vector3D.h"
+
+#include <memory>
+#include <string>
+
+ActRoot::TPCSimRecoWorker::TPCSimRecoWorker(std::shared_ptr<Shared> shared, const std::string& detfile,
+                                            bool print)
+    : TPCSimWorker(shared)
+{
+    fDetMan.ReadDetectorFile(detfile, print);
+    // Each worker reads its own SilSpecs: FindLayerAndIdx is not const
+    fSilSpecs = fDetMan.GetDetectorAs<MergerDetector>()->GetSilSpecs();
+    fLightHandle = fShared->fSRIM->GetHandle("light");
+}
+
+void ActRoot::TPCSimRecoWorker::InitOutput(std::shared_ptr<TTree> tree)
+{
+    // MEventReduced is not written: TPC reads it from memory
+    InitTruthOutput(tree);
+    fDetMan.InitSimuReco(fMEvent, tree);
+    // Detectors renew their data at each init
+    fSilData = fDetMan.GetDetectorAs<SilDetector>()->GetOutputData();
+    fModularData = fDetMan.GetDetectorAs<ModularDetector>()->GetOutputData();
+}
+
+bool ActRoot::TPCSimRecoWorker::Simulate(int run, int entry, TRandom* rand)
+{
+    if(!TPCSimWorker::Simulate(run, entry, rand))
+        return false;
+    // Data of the other detectors, read by Merger
+    fSilData->Clear();
+    fModularData->Clear();
+    FillSilicons();
+    if(fHasGATCONF)
+        fModularData->fLeaves["GATCONF"] = fGATCONF;
+    // TPC algorithms draw from their own stream of (run, entry), not from rand
+    fDetMan.BuildEvent(run, entry);
+    return true;
+}
+
+void ActRoot::TPCSimRecoWorker::FillSilicons()
+{
+    // Same direction as the light track in TrackGenerator::AddRecoil
+    auto phi {fKin.GetPhi3Lab()};
+    ROOT::Math::XYZVector dir {TMath::Cos(fTheta3), TMath::Sin(fTheta3) * TMath::Sin(phi),
+                               TMath::Sin(fTheta3) * TMath::Cos(phi)};
+    auto [layer, idx, sp] {fSilSpecs->FindLayerAndIdx(fVertex, dir)};
+    if(idx == -1)
+        return;
+    auto T {fShared->fSRIM->Slow(fLightHandle, fT3, (sp - fVertex).R())};
+    if(T <= 0)
+        return;
+    fSilData->fSiE[layer].push_back(T);
+    fSilData->fSiN[layer].push_back(idx);
+}
+
+ActRoot::MTSimExecutor::WorkerFactory
+ActRoot::TPCSimRecoWorker::BuildFactory(const std::string& file, const std::string& detfile,
+                                        const std::string& calfile)
+{
+    auto shared {ReadShared(file)};
+    ActRoot::InputParser parser {file};
+    auto block {parser.GetBlock("Simulation")};
+    bool hasGat {block->CheckTokenExists("GATCONF", true)};
+    float gat {hasGat ? static_cast<float>(block->GetInt("GATCONF")) : 0.f};
+    // Calibrations are read by the first worker and shared read-only with the rest, as in MTExecutor
+    auto calman {std::make_shared<std::shared_ptr<CalibrationManager>>()};
+    return [=](unsigned int thread)
+    {
+        auto worker {std::make_shared<TPCSimRecoWorker>(shared, detfile, thread == 0)};
+        auto& detman {worker->GetDetMan()};
+        if(!*calman)
+        {
+            detman.ReadCalibrationsFile(calfile);
+            *calman = detman.GetCalMan();
+        }
+        else
+            detman.SetCalMan(*calman);
+        if(hasGat)
+            worker->SetGATCONF(gat);
+        return worker;
+    };
+}
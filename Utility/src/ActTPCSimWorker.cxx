@@ -0,0 +1,114 @@
+#include "ActTPCSimWorker.h"
+
+#include "ActCalibrationManager.h"
+#include "ActCrossSection.h"
+#include "ActGas.h"
+#include "ActInputParser.h"
+#include "ActKinematics.h"
+#include "ActMTSimExecutor.h"
+#include "ActSRIM.h"
+#include "ActTPCLegacyData.h"
+#include "ActTPCParameters.h"
+#include "ActTrackGenerator.h"
+
+#include "TMath.h"
+#include "TRandom.h"
+#include "TTree.h"
+
+#include <memory>
+#include <string>
+
+ActRoot::TPCSimWorker::TPCSimWorker(std::shared_ptr<Shared> shared)
+    : fShared(shared),
+      fTracks(shared->fSRIM.get(), shared->fTPC.get(), shared->fGas.get())
+{
+    fTracks.ReadConfiguration(fShared->fTrackBlock);
+    fTracks.SetCalibrations(fShared->fCalMan.get());
+    fMEvent = fTracks.GetMEvent();
+    // Each worker owns its kinematics: they store the last computed event
+    fKin.ReadConfiguration(fShared->fKinBlock);
+    fTBeam = fKin.GetT1Lab();
+}
+
+void ActRoot::TPCSimWorker::InitOutput(std::shared_ptr<TTree> tree)
+{
+    // Same branch as raw data, so the output can be reconstructed as an experimental run
+    tree->Branch("data", &fMEvent);
+    InitTruthOutput(tree);
+}
+
+void ActRoot::TPCSimWorker::InitTruthOutput(std::shared_ptr<TTree> tree)
+{
+    tree->Branch("Vertex", &fVertex);
+    tree->Branch("TVertex", &fTVertex);
+    tree->Branch("ThetaCM", &fThetaCM);
+    tree->Branch("T3", &fT3);
+    tree->Branch("Theta3", &fTheta3);
+    tree->Branch("T4", &fT4);
+    tree->Branch("Theta4", &fTheta4);
+}
+
+bool ActRoot::TPCSimWorker::Simulate(int run, int entry, TRandom* rand)
+{
+    fTracks.SetTRandom(rand);
+    fTracks.Reset();
+    // 1-> Vertex and beam energy at it
+    fTracks.GenVertex();
+    fVertex = fTracks.GetVertex();
+    fTVertex = fTracks.AddBeam(fTBeam);
+    if(fTVertex <= 0 || fTVertex < fKin.GetT1Thresh())
+        return false;
+    fKin.SetBeamEnergy(fTVertex);
+    // 2-> Reaction
+    if(fShared->fXS)
+        fThetaCM = fShared->fXS->Sample(rand) * TMath::DegToRad();
+    else
+        fThetaCM = TMath::ACos(rand->Uniform(-1, 1));
+    auto phiCM {rand->Uniform(0, TMath::TwoPi())};
+    fKin.ComputeRecoilKinematics(fThetaCM, phiCM);
+    fT3 = fKin.GetT3Lab();
+    fTheta3 = fKin.GetTheta3Lab();
+    fT4 = fKin.GetT4Lab();
+    fTheta4 = fKin.GetTheta4Lab();
+    // 3-> Recoils
+    fTracks.AddRecoil("light", fT3, fTheta3, fKin.GetPhi3Lab());
+    fTracks.AddRecoil("heavy", fT4, fTheta4, fKin.GetPhi4Lab());
+    // 4-> Signals in pads
+    fTracks.Convert();
+    return true;
+}
+
+std::shared_ptr<ActRoot::TPCSimWorker::Shared> ActRoot::TPCSimWorker::ReadShared(const std::string& file)
+{
+    ActRoot::InputParser parser {file};
+    auto block {parser.GetBlock("Simulation")};
+    auto shared {std::make_shared<Shared>()};
+    // 1-> Energy losses, with the keys used by TrackGenerator
+    shared->fSRIM = std::make_shared<ActPhysics::SRIM>();
+    shared->fSRIM->ReadTable("beam", block->GetString("BeamSRIM"));
+    shared->fSRIM->ReadTable("light", block->GetString("LightSRIM"));
+    shared->fSRIM->ReadTable("heavy", block->GetString("HeavySRIM"));
+    // 2-> Chamber
+    shared->fTPC = std::make_shared<TPCParameters>(block->GetString("TPC"));
+    if(block->CheckTokenExists("REBINZ", true))
+        shared->fTPC->SetREBINZ(block->GetInt("REBINZ"));
+    shared->fGas = std::make_shared<ActPhysics::Gas>();
+    shared->fGas->ReadConfiguration(parser.GetBlock("Gas"));
+    shared->fCalMan = std::make_shared<CalibrationManager>();
+    shared->fCalMan->ReadInvertedLookUpTable(block->GetString("InvLookUp"));
+    // 3-> Reaction
+    if(block->CheckTokenExists("CrossSection", true))
+    {
+        shared->fXS = std::make_shared<ActSim::CrossSection>();
+        shared->fXS->ReadFile(block->GetString("CrossSection"));
+    }
+    shared->fKinBlock = parser.GetBlock("Kinematics");
+    shared->fTrackBlock = parser.GetBlock("TrackGenerator");
+    return shared;
+}
+
+ActRoot::MTSimExecutor::WorkerFactory ActRoot::TPCSimWorker::BuildFactory(const std::string& file)
+{
+    auto shared {ReadShared(file)};
+    return [shared](unsigned int thread) { return std::make_shared<TPCSimWorker>(shared); };
+}